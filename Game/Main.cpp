@@ -1,14 +1,107 @@
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
+#include <Core/Config.h>
+#include <Core/FileSystem.h>
 #include <Core/GameManager.h>
+#include <Core/ResourceArchive.h>
+#include <Physics/PhysicsDeterminismCheck.h>
 #include <Tools/Debug.h>
+#include <Tools/EngineStats.h>
 #include "Game.h"
 
+//Packs the Resources folder into the archive the engine reads from, without starting the engine
+//Usage: Game --pack [archive] [--no-compress] [--align bytes]
+static int PackResources(int argc, char* argv[]){
+	std::string archive = PizzaBox::ResourceArchive::defaultArchive;
+	bool compress = true;
+	unsigned int alignment = 16;
+
+	for(int i = 2; i < argc; i++){
+		const std::string arg = argv[i];
+		if(arg == "--no-compress"){
+			compress = false;
+		}else if(arg == "--align"){
+			//Alignments have to be a whole number of bytes, anything else is a typo that shouldn't silently become the archive's name
+			char* end = nullptr;
+			errno = 0;
+			const unsigned long value = (i + 1 < argc) ? std::strtoul(argv[i + 1], &end, 10) : 0;
+			if(end == nullptr || end == argv[i + 1] || *end != '\0' || argv[i + 1][0] == '-' || errno == ERANGE || value == 0 || value > UINT_MAX){
+				std::cout << "Error: --align needs a positive number of bytes!" << std::endl;
+				std::cout << "Usage: Game --pack [archive] [--no-compress] [--align bytes]" << std::endl;
+				return 1;
+			}
+
+			alignment = static_cast<unsigned int>(value);
+			i++;
+		}else{
+			archive = arg;
+		}
+	}
+
+	if(PizzaBox::ResourceArchive::Pack("Resources", archive, compress, alignment) == false){
+		std::cout << "Error: Resources could not be packed into " << archive << "!" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Packed Resources into " << archive << std::endl;
+	return 0;
+}
+
+//Runs the same scripted physics scene with serial and threaded stepping and checks that they agree, without opening a window
+//Usage: Game --check-physics [frames]
+static int CheckPhysics(int argc, char* argv[]){
+	int frames = 600;
+	if(argc >= 3){
+		char* end = nullptr;
+		errno = 0;
+		const long value = std::strtol(argv[2], &end, 10);
+		if(end == argv[2] || *end != '\0' || errno == ERANGE || value <= 0 || value > INT_MAX){
+			std::cout << "Error: frames must be a positive number!" << std::endl;
+			std::cout << "Usage: Game --check-physics [frames]" << std::endl;
+			return 1;
+		}
+
+		frames = static_cast<int>(value);
+	}
+
+	if(PizzaBox::Debug::Initialize() == false || PizzaBox::EngineStats::Initialize() == false || PizzaBox::FileSystem::Initialize() == false || PizzaBox::Config::Initialize() == false){
+		std::cout << "Error: The engine could not be initialized!" << std::endl;
+		return 1;
+	}
+
+	const bool matched = PizzaBox::PhysicsDeterminismCheck::Run(frames);
+
+	PizzaBox::Config::Destroy();
+	PizzaBox::FileSystem::Destroy();
+	PizzaBox::EngineStats::Destroy();
+	PizzaBox::Debug::Destroy();
+
+	if(!matched){
+		std::cout << "Error: Serial and threaded physics did not match!" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Serial and threaded physics matched over " << frames << " frames" << std::endl;
+	return 0;
+}
+
 int main(int argc, char* argv[]){
 	//This will cause compilation to fail for a 64-bit build
 	//static_assert(sizeof(void*) == 4, "This program is not ready for 64-bit build");
 	static_assert(PizzaBox::GameManager::version == 2019'04'16, "Invalid engine version!");
 
+	if(argc >= 2 && std::string(argv[1]) == "--pack"){
+		return PackResources(argc, argv);
+	}
+
+	if(argc >= 2 && std::string(argv[1]) == "--check-physics"){
+		return CheckPhysics(argc, argv);
+	}
+
 	//Create the Game
 	GamePackage::Game* game = new GamePackage::Game("ProtoType");
 
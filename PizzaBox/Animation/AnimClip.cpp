@@ -67,6 +67,23 @@ void AnimClip::Unload(){
 	scaleKeys.clear();
 }
 
+size_t AnimClip::GetByteSize() const{
+	size_t size = 0;
+	for(const auto& keys : posKeys){
+		size += keys.first.size() + (keys.second.size() * sizeof(PosKeyFrame));
+	}
+
+	for(const auto& keys : rotKeys){
+		size += keys.first.size() + (keys.second.size() * sizeof(RotKeyFrame));
+	}
+
+	for(const auto& keys : scaleKeys){
+		size += keys.first.size() + (keys.second.size() * sizeof(ScaleKeyFrame));
+	}
+
+	return size;
+}
+
 void AnimClip::AddPosKey(const std::string& name_, const PosKeyFrame& keyFrame_){
 	if(posKeys.find(name_) == posKeys.end()){
 		posKeys[name_] = std::vector<PosKeyFrame>{ keyFrame_ };
@@ -28,6 +28,7 @@ namespace PizzaBox{
 
 		virtual bool Load() override;
 		virtual void Unload() override;
+		virtual size_t GetByteSize() const override;
 
 		inline float GetLength() const{ return length; }
 		inline void SetLength(float length_){ length = length_; }
@@ -1,10 +1,12 @@
 #include "AnimMesh.h"
 
+#include "SkinWeightBuilder.h"
+#include "Core/Config.h"
 #include "Tools/Debug.h"
 
 using namespace PizzaBox;
 
-AnimMesh::AnimMesh(const std::vector<AnimVertex>& verts_, const std::vector<unsigned int>& indices_, const Skeleton* skeleton_, const SkinningData& skinningData_, size_t meshIndex_) : vertices(verts_), indices(indices_), vao(), vbo(GL_ARRAY_BUFFER), ebo(GL_ELEMENT_ARRAY_BUFFER){
+AnimMesh::AnimMesh(const std::vector<AnimVertex>& verts_, const std::vector<unsigned int>& indices_, const Skeleton* skeleton_, const SkinningData& skinningData_, size_t meshIndex_) : vertices(verts_), indices(indices_), vao(), vbo(GL_ARRAY_BUFFER), ebo(GL_ELEMENT_ARRAY_BUFFER), usesCompactVertices(false){
 	SetVertexWeights(skeleton_, skinningData_, meshIndex_);
 	GenerateBuffers();
 }
@@ -26,43 +28,65 @@ void AnimMesh::Render() const{
 }
 
 void AnimMesh::SetVertexWeights(const Skeleton* skeleton_, const SkinningData& skinningData_, size_t meshIndex_){
-	std::map<size_t, std::vector<VertexWeight>> allPairsByVertex;
-	for(size_t i = 0; i < vertices.size(); i++){
-		allPairsByVertex[i] = std::vector<VertexWeight>();
-		allPairsByVertex[i].reserve(4);
-	}
+	SkinWeightBuilder builder = SkinWeightBuilder(vertices.size());
 
+	//First pass counts the influences on each vertex so they can all be stored in one flat array
 	for(unsigned int i = 0; i < skeleton_->GetJointCount(); i++){
-		std::string jointName = skeleton_->GetJoint(i).name;
+		const std::string& jointName = skeleton_->GetJoint(i).name;
 		if(skinningData_.HasDataForJoint(meshIndex_, jointName)){
-			auto dataForThis = skinningData_.GetDataForJoint(meshIndex_, jointName);
-			for(unsigned int j = 0; j < dataForThis.size(); j++){
-				allPairsByVertex[dataForThis[j].id].push_back(VertexWeight(i, dataForThis[j].weight));
+			for(const auto& vw : skinningData_.GetDataForJoint(meshIndex_, jointName)){
+				builder.CountInfluence(vw.id);
 			}
 		}
 	}
 
-	for(size_t i = 0; i < vertices.size(); i++){
-		for(size_t j = 0; j < allPairsByVertex[i].size() && j < AnimVertex::maxJointWeights; j++){
-			vertices[i].jointIDs[j] = static_cast<unsigned int>(allPairsByVertex[i][j].id);
-			vertices[i].jointWeights[j] = allPairsByVertex[i][j].weight;
+	//Second pass fills in the influences
+	for(unsigned int i = 0; i < skeleton_->GetJointCount(); i++){
+		const std::string& jointName = skeleton_->GetJoint(i).name;
+		if(skinningData_.HasDataForJoint(meshIndex_, jointName)){
+			for(const auto& vw : skinningData_.GetDataForJoint(meshIndex_, jointName)){
+				builder.AddInfluence(vw.id, i, vw.weight);
+			}
 		}
 	}
+
+	builder.Build(vertices);
+
+	//Compact vertices store joint IDs in a byte, so they can only be used with skeletons of up to 256 joints
+	usesCompactVertices = Config::GetBool("CompactSkinnedVertices") && skeleton_->GetJointCount() <= 256;
 }
 
 void AnimMesh::GenerateBuffers(){
 	vao.Bind();
 	vbo.Bind();
-	vbo.SetBufferData(vertices.size() * sizeof(AnimVertex), &vertices[0], GL_STATIC_DRAW);
+
+	if(usesCompactVertices){
+		std::vector<CompactAnimVertex> compactVertices = std::vector<CompactAnimVertex>(vertices.size());
+		for(size_t i = 0; i < vertices.size(); i++){
+			SkinWeightBuilder::Pack(vertices[i], compactVertices[i]);
+		}
+
+		vbo.SetBufferData(compactVertices.size() * sizeof(CompactAnimVertex), &compactVertices[0], GL_STATIC_DRAW);
+	}else{
+		vbo.SetBufferData(vertices.size() * sizeof(AnimVertex), &vertices[0], GL_STATIC_DRAW);
+	}
 
 	ebo.Bind();
 	ebo.SetBufferData(indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
 
-	vao.SetupVertexAttribute(0, 3, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::position)));
-	vao.SetupVertexAttribute(1, 3, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::normal)));
-	vao.SetupVertexAttribute(2, 2, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::texCoords)));
-	vao.SetupVertexIntAttribute(3, 4, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::jointIDs)));
-	vao.SetupVertexAttribute(4, 4, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::jointWeights)));
+	if(usesCompactVertices){
+		vao.SetupVertexAttribute(0, 3, sizeof(CompactAnimVertex), (GLvoid*)(offsetof(CompactAnimVertex, CompactAnimVertex::position)));
+		vao.SetupVertexAttribute(1, 3, sizeof(CompactAnimVertex), (GLvoid*)(offsetof(CompactAnimVertex, CompactAnimVertex::normal)));
+		vao.SetupVertexAttribute(2, 2, sizeof(CompactAnimVertex), (GLvoid*)(offsetof(CompactAnimVertex, CompactAnimVertex::texCoords)));
+		vao.SetupVertexIntAttribute(3, 4, sizeof(CompactAnimVertex), (GLvoid*)(offsetof(CompactAnimVertex, CompactAnimVertex::jointIDs)), GL_UNSIGNED_BYTE);
+		vao.SetupVertexAttribute(4, 4, sizeof(CompactAnimVertex), (GLvoid*)(offsetof(CompactAnimVertex, CompactAnimVertex::jointWeights)), GL_UNSIGNED_SHORT, GL_TRUE);
+	}else{
+		vao.SetupVertexAttribute(0, 3, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::position)));
+		vao.SetupVertexAttribute(1, 3, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::normal)));
+		vao.SetupVertexAttribute(2, 2, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::texCoords)));
+		vao.SetupVertexIntAttribute(3, 4, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::jointIDs)));
+		vao.SetupVertexAttribute(4, 4, sizeof(AnimVertex), (GLvoid*)(offsetof(AnimVertex, AnimVertex::jointWeights)));
+	}
 
 	vbo.Unbind();
 	vao.Unbind();
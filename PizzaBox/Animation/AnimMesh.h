@@ -24,6 +24,7 @@ namespace PizzaBox{
 		VAO vao;
 		Buffer vbo;
 		Buffer ebo;
+		bool usesCompactVertices;
 
 		void SetVertexWeights(const Skeleton* skeleton_, const SkinningData& skinningData_, size_t meshIndex_);
 		void GenerateBuffers();
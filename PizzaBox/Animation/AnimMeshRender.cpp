@@ -11,8 +11,8 @@
 
 using namespace PizzaBox;
 
-AnimMeshRender::AnimMeshRender(const std::string& modelName_, const std::string& textureName_, Animator* animator_) : Component(), modelName(modelName_), model(nullptr), materials(), animator(animator_), castsShadows(true){
-	_ASSERT(!modelName.empty());
+AnimMeshRender::AnimMeshRender(const std::string& modelName_, const std::string& textureName_, Animator* animator_) : Component(), modelHandle(ResourceManager::GetHandle<AnimModel>(modelName_)), model(nullptr), materials(), animator(animator_), castsShadows(true){
+	_ASSERT(!modelName_.empty());
 	_ASSERT(!textureName_.empty());
 
 	if(animator != nullptr){
@@ -22,7 +22,7 @@ AnimMeshRender::AnimMeshRender(const std::string& modelName_, const std::string&
 	}
 }
 
-AnimMeshRender::AnimMeshRender(const std::string& modelName_, const Color& color_, Animator* animator_) : Component(), modelName(modelName_), model(nullptr), materials(), animator(animator_), castsShadows(true){
+AnimMeshRender::AnimMeshRender(const std::string& modelName_, const Color& color_, Animator* animator_) : Component(), modelHandle(ResourceManager::GetHandle<AnimModel>(modelName_)), model(nullptr), materials(), animator(animator_), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 
 	if(animator != nullptr){
@@ -32,12 +32,12 @@ AnimMeshRender::AnimMeshRender(const std::string& modelName_, const Color& color
 	}
 }
 
-AnimMeshRender::AnimMeshRender(const std::string& modelName_, const std::vector<MeshMaterial*>& materials_, Animator* animator_) : Component(), modelName(modelName_), model(nullptr), materials(materials_), animator(animator_), castsShadows(true){
+AnimMeshRender::AnimMeshRender(const std::string& modelName_, const std::vector<MeshMaterial*>& materials_, Animator* animator_) : Component(), modelHandle(ResourceManager::GetHandle<AnimModel>(modelName_)), model(nullptr), materials(materials_), animator(animator_), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 	_ASSERT(!materials_.empty());
 }
 
-AnimMeshRender::AnimMeshRender(const std::string& modelName_, Animator* animator_) : Component(), modelName(modelName_), model(nullptr), materials(), animator(animator_), castsShadows(true){
+AnimMeshRender::AnimMeshRender(const std::string& modelName_, Animator* animator_) : Component(), modelHandle(ResourceManager::GetHandle<AnimModel>(modelName_)), model(nullptr), materials(), animator(animator_), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 }
 
@@ -67,7 +67,14 @@ bool AnimMeshRender::Initialize(GameObject* go_){
 
 	gameObject = go_;
 
-	model = ResourceManager::LoadResource<AnimModel>(modelName);
+	//Share one import of the model file between the model, its materials and any animation clips
+	ModelLoader::ImportScope importScope;
+
+	//Clones come in with their model already referenced
+	if(model == nullptr){
+		model = ResourceManager::LoadResource(modelHandle);
+	}
+
 	if(model == nullptr || model->meshList.size() == 0){
 		Debug::LogError("Model was not loaded correctly", __FILE__, __LINE__);
 		return false;
@@ -114,13 +121,40 @@ void AnimMeshRender::Destroy(){
 	}
 
 	if(model != nullptr){
-		ResourceManager::UnloadResource(modelName);
+		ResourceManager::UnloadResource(modelHandle);
 		model = nullptr;
 	}
 
 	gameObject = nullptr;
 }
 
+Component* AnimMeshRender::Clone() const{
+	std::vector<MeshMaterial*> materialClones;
+	materialClones.reserve(materials.size());
+	for(const auto& m : materials){
+		MeshMaterial* clone = (m == nullptr) ? nullptr : m->Clone();
+		if(m != nullptr && clone == nullptr){
+			for(auto& c : materialClones){
+				if(c != nullptr){
+					c->Destroy();
+					delete c;
+				}
+			}
+
+			return nullptr;
+		}
+
+		materialClones.push_back(clone);
+	}
+
+	//Each copy animates on its own, so it needs an animator of its own as well
+	AnimMeshRender* clone = new AnimMeshRender(*this);
+	clone->model = ResourceManager::AddReference(model);
+	clone->materials = materialClones;
+	clone->animator = (animator == nullptr) ? nullptr : animator->Clone();
+	return clone;
+}
+
 void AnimMeshRender::Update(float deltaTime_){
 	if(animator != nullptr){
 		animator->Update(deltaTime_);
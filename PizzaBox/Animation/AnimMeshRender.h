@@ -12,6 +12,7 @@
 #include "Graphics/Lighting/SpotLight.h"
 #include "Graphics/Materials/MeshMaterial.h"
 #include "Object/Component.h"
+#include "Resource/ResourceHandle.h"
 
 namespace PizzaBox{
 	class AnimMeshRender : public Component{
@@ -24,6 +25,7 @@ namespace PizzaBox{
 
 		virtual bool Initialize(GameObject* go_) override;
 		virtual void Destroy() override;
+		virtual Component* Clone() const override;
 
 		void Update(float deltaTime_);
 		void Render(Camera* camera_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_) const;
@@ -39,7 +41,7 @@ namespace PizzaBox{
 		void BindSkeletonInstance(Shader* shader_) const;
 
 	private:
-		std::string modelName;
+		ResourceHandle<AnimModel> modelHandle;
 		AnimModel* model;
 		std::vector<MeshMaterial*> materials;
 		Animator* animator;
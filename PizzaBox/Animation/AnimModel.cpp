@@ -36,4 +36,14 @@ void AnimModel::Unload(){
 
 	meshList.clear();
 	meshList.shrink_to_fit();
+}
+
+size_t AnimModel::GetByteSize() const{
+	//Meshes keep a copy of their vertices on top of the one in the GPU's buffers
+	size_t size = 0;
+	for(const AnimMesh* mesh : meshList){
+		size += 2 * ((mesh->vertices.size() * sizeof(AnimVertex)) + (mesh->indices.size() * sizeof(unsigned int)));
+	}
+
+	return size;
 }
\ No newline at end of file
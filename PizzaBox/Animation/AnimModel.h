@@ -20,6 +20,8 @@ namespace PizzaBox{
 
 		virtual bool Load() override;
 		virtual void Unload() override;
+		virtual size_t GetByteSize() const override;
+		virtual ResourceType GetType() const override{ return ResourceType::Model; }
 	};
 }
 
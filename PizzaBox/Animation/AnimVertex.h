@@ -16,6 +16,18 @@ namespace PizzaBox{
 		unsigned int jointIDs[maxJointWeights];
 		float jointWeights[maxJointWeights];
 	};
+
+	//Smaller GPU layout for skinned vertices, joint IDs are stored as bytes and weights as 16-bit unsigned normalized values
+	struct CompactAnimVertex{
+		CompactAnimVertex() : position(), normal(), texCoords(), jointIDs(), jointWeights(){
+		}
+
+		Vector3 position;
+		Vector3 normal;
+		Vector2 texCoords;
+		unsigned char jointIDs[AnimVertex::maxJointWeights];
+		unsigned short jointWeights[AnimVertex::maxJointWeights];
+	};
 }
 
 #endif //!ANIM_VERTEX_H
\ No newline at end of file
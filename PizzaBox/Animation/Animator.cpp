@@ -46,8 +46,9 @@ bool Animator::Initialize(AnimModel* model_){
 	skeleton = model_->skeleton;
 	skeletonInstance = skeleton->CreateInstance();
 
-	for(const auto& name : clipNames){
-		AnimClip* temp = ResourceManager::LoadResource<AnimClip>(name);
+	//Clones come in with their clips already referenced
+	for(size_t i = clips.size(); i < clipNames.size(); i++){
+		AnimClip* temp = ResourceManager::LoadResource<AnimClip>(clipNames[i]);
 		if(temp == nullptr){
 			return false;
 		}
@@ -65,8 +66,9 @@ void Animator::Destroy(){
 	isInitialized = false;
 	AnimEngine::UnregisterAnimator(this);
 
-	for(auto& name : clipNames){
-		ResourceManager::UnloadResource(name);
+	//Only the clips that were actually loaded hold a reference
+	for(size_t i = 0; i < clips.size() && i < clipNames.size(); i++){
+		ResourceManager::UnloadResource(clipNames[i]);
 	}
 
 	skeletonInstance.clear();
@@ -94,6 +96,19 @@ void Animator::Destroy(){
 	}
 }
 
+Animator* Animator::Clone() const{
+	Animator* clone = new Animator();
+	clone->clipNames = clipNames;
+	clone->currentClip = currentClip;
+
+	clone->clips.reserve(clips.size());
+	for(AnimClip* clip : clips){
+		clone->clips.push_back(ResourceManager::AddReference(clip));
+	}
+
+	return clone;
+}
+
 void Animator::Update(float deltaTime_){
 	globalTime += deltaTime_;
 
@@ -14,6 +14,8 @@ namespace PizzaBox{
 
 		virtual bool Initialize(AnimModel* model_);
 		virtual void Destroy();
+		//Makes an uninitialized copy that plays the same clips from the start, sharing this one's references to them
+		virtual Animator* Clone() const;
 
 		virtual void Update(float deltaTime_);
 
@@ -0,0 +1,109 @@
+#include "SkinWeightBuilder.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+SkinWeightBuilder::SkinWeightBuilder(size_t vertexCount_) : vertexCount(vertexCount_), offsets(vertexCount_ + 1, 0), cursors(), influences(), isAllocated(false){
+}
+
+void SkinWeightBuilder::CountInfluence(size_t vertex_){
+	//All influences must be counted before any of them are added
+	_ASSERT(!isAllocated);
+	_ASSERT(vertex_ < vertexCount);
+
+	//Counts are stored one slot ahead so that the prefix sum turns them straight into offsets
+	offsets[vertex_ + 1]++;
+}
+
+void SkinWeightBuilder::AddInfluence(size_t vertex_, unsigned int joint_, float weight_){
+	_ASSERT(vertex_ < vertexCount);
+
+	if(!isAllocated){
+		Allocate();
+	}
+
+	//If this triggers, this influence was never counted
+	_ASSERT(cursors[vertex_] < offsets[vertex_ + 1]);
+
+	Influence& influence = influences[cursors[vertex_]];
+	influence.joint = joint_;
+	influence.weight = weight_;
+	cursors[vertex_]++;
+}
+
+void SkinWeightBuilder::Build(std::vector<AnimVertex>& vertices_){
+	_ASSERT(vertices_.size() == vertexCount);
+
+	if(!isAllocated){
+		Allocate();
+	}
+
+	for(size_t i = 0; i < vertexCount; i++){
+		auto begin = influences.begin() + offsets[i];
+		auto end = influences.begin() + cursors[i];
+		const size_t count = static_cast<size_t>(end - begin);
+		const size_t kept = std::min(count, static_cast<size_t>(AnimVertex::maxJointWeights));
+
+		//Move the strongest influences to the front, we don't care about the order of the rest
+		std::partial_sort(begin, begin + kept, end, [](const Influence& a_, const Influence& b_){
+			return a_.weight > b_.weight;
+		});
+
+		float total = 0.0f;
+		for(size_t j = 0; j < kept; j++){
+			total += begin[j].weight;
+		}
+
+		for(size_t j = 0; j < AnimVertex::maxJointWeights; j++){
+			if(j < kept && total > 0.0f){
+				vertices_[i].jointIDs[j] = begin[j].joint;
+				vertices_[i].jointWeights[j] = begin[j].weight / total;
+			}else{
+				vertices_[i].jointIDs[j] = 0;
+				vertices_[i].jointWeights[j] = 0.0f;
+			}
+		}
+	}
+}
+
+void SkinWeightBuilder::Pack(const AnimVertex& vertex_, CompactAnimVertex& packed_){
+	constexpr unsigned int maxWeight = std::numeric_limits<unsigned short>::max();
+
+	packed_.position = vertex_.position;
+	packed_.normal = vertex_.normal;
+	packed_.texCoords = vertex_.texCoords;
+
+	unsigned int total = 0;
+	unsigned int strongest = 0;
+	for(unsigned int i = 0; i < AnimVertex::maxJointWeights; i++){
+		//Compact vertices can only address 256 joints
+		_ASSERT(vertex_.jointIDs[i] <= std::numeric_limits<unsigned char>::max());
+
+		packed_.jointIDs[i] = static_cast<unsigned char>(vertex_.jointIDs[i]);
+		packed_.jointWeights[i] = static_cast<unsigned short>(std::min(vertex_.jointWeights[i], 1.0f) * maxWeight + 0.5f);
+		total += packed_.jointWeights[i];
+
+		if(packed_.jointWeights[i] > packed_.jointWeights[strongest]){
+			strongest = i;
+		}
+	}
+
+	//Give any rounding error to the strongest influence so the packed weights still add up to exactly 1
+	if(total > 0){
+		packed_.jointWeights[strongest] = static_cast<unsigned short>(static_cast<int>(packed_.jointWeights[strongest]) + static_cast<int>(maxWeight) - static_cast<int>(total));
+	}
+}
+
+void SkinWeightBuilder::Allocate(){
+	for(size_t i = 0; i < vertexCount; i++){
+		offsets[i + 1] += offsets[i];
+	}
+
+	cursors.assign(offsets.begin(), offsets.end() - 1);
+	influences.resize(offsets[vertexCount]);
+	isAllocated = true;
+}
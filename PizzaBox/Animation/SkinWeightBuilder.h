@@ -0,0 +1,39 @@
+#ifndef SKIN_WEIGHT_BUILDER_H
+#define SKIN_WEIGHT_BUILDER_H
+
+#include <vector>
+
+#include "AnimVertex.h"
+
+namespace PizzaBox{
+	//Gathers joint influences for a mesh into one flat array (counting sort style) instead of a container per vertex
+	//Usage is two passes over the influences: CountInfluence for every influence, then AddInfluence for every influence
+	class SkinWeightBuilder{
+	public:
+		explicit SkinWeightBuilder(size_t vertexCount_);
+
+		void CountInfluence(size_t vertex_);
+		void AddInfluence(size_t vertex_, unsigned int joint_, float weight_);
+
+		//Keeps the strongest influences for each vertex and renormalizes them so they add up to 1
+		void Build(std::vector<AnimVertex>& vertices_);
+
+		static void Pack(const AnimVertex& vertex_, CompactAnimVertex& packed_);
+
+	private:
+		struct Influence{
+			unsigned int joint;
+			float weight;
+		};
+
+		size_t vertexCount;
+		std::vector<unsigned int> offsets;
+		std::vector<unsigned int> cursors;
+		std::vector<Influence> influences;
+		bool isAllocated;
+
+		void Allocate();
+	};
+}
+
+#endif //!SKIN_WEIGHT_BUILDER_H
@@ -1,8 +1,12 @@
 #include "AudioManager.h"
 
+#include <cstring>
+#include <vector>
+
 #include <fmod_errors.h>
 
 #include "Core/Config.h"
+#include "Core/ResourceArchive.h"
 #include "Core/SceneManager.h"
 #include "Math/Math.h"
 #include "Tools/Debug.h"
@@ -137,15 +141,30 @@ void AudioManager::Update(){
 }
 
 bool AudioManager::CreateSound(const std::string& filePath_, FMOD::Sound** sound2D_, FMOD::Sound** sound3D_){
+	//Sounds in the resource archive are created from memory, FMOD decodes them into samples of its own so the buffer can go afterwards
+	std::vector<char> archived;
+	const char* source = filePath_.c_str();
+	FMOD_MODE sourceMode = FMOD_DEFAULT;
+	FMOD_CREATESOUNDEXINFO info;
+	FMOD_CREATESOUNDEXINFO* exInfo = nullptr;
+	if(ResourceArchive::ReadEntry(filePath_, archived)){
+		memset(&info, 0, sizeof(info));
+		info.cbsize = sizeof(info);
+		info.length = static_cast<unsigned int>(archived.size());
+		source = archived.data();
+		sourceMode = FMOD_OPENMEMORY;
+		exInfo = &info;
+	}
+
 	//Load the sound as a 2D sound
-	FMOD_RESULT result = system->createSound(filePath_.c_str(), FMOD_2D, 0, sound2D_);
+	FMOD_RESULT result = system->createSound(source, FMOD_2D | sourceMode, exInfo, sound2D_);
 	if(result != FMOD_OK){
 		Debug::LogError("2D Sound could not be created! FMOD Error Code: " + std::string(FMOD_ErrorString(result)), __FILE__, __LINE__);
 		return false;
 	}
 
 	//Load the sound as a 3D sound
-	result = system->createSound(filePath_.c_str(), FMOD_3D, 0, sound3D_);
+	result = system->createSound(source, FMOD_3D | sourceMode, exInfo, sound3D_);
 	if(result != FMOD_OK){
 		Debug::LogError("3D Sound could not be created! FMOD Error Code: " + std::string(FMOD_ErrorString(result)), __FILE__, __LINE__);
 		return false;
@@ -46,6 +46,21 @@ void AudioResource::Unload(){
 	}
 }
 
+size_t AudioResource::GetByteSize() const{
+	//Both versions of the sound are fully decoded into memory
+	size_t size = 0;
+	unsigned int length = 0;
+	if(sound2D != nullptr && sound2D->getLength(&length, FMOD_TIMEUNIT_PCMBYTES) == FMOD_OK){
+		size += length;
+	}
+
+	if(sound3D != nullptr && sound3D->getLength(&length, FMOD_TIMEUNIT_PCMBYTES) == FMOD_OK){
+		size += length;
+	}
+
+	return size;
+}
+
 FMOD::Sound* AudioResource::Sound2D(){
 	return sound2D;
 }
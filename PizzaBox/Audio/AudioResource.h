@@ -13,6 +13,8 @@ namespace PizzaBox{
 
 		bool Load() override;
 		void Unload() override;
+		size_t GetByteSize() const override;
+		ResourceType GetType() const override{ return ResourceType::Audio; }
 
 		FMOD::Sound* Sound2D();
 		FMOD::Sound* Sound3D();
@@ -43,7 +43,11 @@ bool AudioSource::Initialize(GameObject* go_){
 
 	gameObject = go_;
 
-	sound = ResourceManager::LoadResource<AudioResource>(resourceName);
+	//Clones come in with their sound already referenced
+	if(sound == nullptr){
+		sound = ResourceManager::LoadResource<AudioResource>(resourceName);
+	}
+
 	if(sound == nullptr){
 		Debug::LogError("Could not load sound file!", __FILE__, __LINE__);
 		return false;
@@ -68,6 +72,14 @@ void AudioSource::Destroy(){
 	gameObject = nullptr;
 }
 
+Component* AudioSource::Clone() const{
+	//Whatever this source is playing stays with it
+	AudioSource* clone = new AudioSource(resourceName, soundType, volumeChannel);
+	clone->SetEnable(GetEnable());
+	clone->sound = ResourceManager::AddReference(sound);
+	return clone;
+}
+
 void AudioSource::Update(){
 	for(FMOD::Channel* channel : playingChannels){
 		channel->setVolume(AudioManager::MasterVolume() * AudioManager::GetVolume(volumeChannel));
@@ -22,6 +22,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		Component* Clone() const override;
 
 		void Update();
 		void PlayOnce();
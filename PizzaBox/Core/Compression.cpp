@@ -0,0 +1,161 @@
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+using namespace PizzaBox;
+
+//Initialize static variables here
+constexpr size_t Compression::minMatch;
+constexpr size_t Compression::maxOffset;
+constexpr size_t Compression::lastLiterals;
+constexpr size_t Compression::matchLimit;
+constexpr unsigned int Compression::hashBits;
+
+std::vector<char> Compression::Compress(const char* source_, size_t sourceSize_){
+	std::vector<char> output;
+	output.reserve(sourceSize_ + (sourceSize_ / 255) + 16);
+
+	const unsigned char* source = reinterpret_cast<const unsigned char*>(source_);
+	//Where each hashed group of four bytes was last seen
+	std::vector<size_t> table(static_cast<size_t>(1) << hashBits, 0);
+
+	size_t anchor = 0; //Start of the literals that haven't been written yet
+	size_t i = 0;
+	const size_t matchEnd = (sourceSize_ > matchLimit) ? sourceSize_ - matchLimit : 0;
+
+	while(i < matchEnd){
+		uint32_t sequence;
+		memcpy(&sequence, source + i, sizeof(sequence));
+		const size_t hash = static_cast<size_t>((sequence * 2654435761u) >> (32 - hashBits));
+
+		const size_t candidate = table[hash];
+		table[hash] = i;
+
+		uint32_t candidateSequence;
+		memcpy(&candidateSequence, source + candidate, sizeof(candidateSequence));
+		if(candidate >= i || i - candidate > maxOffset || candidateSequence != sequence){
+			i++;
+			continue;
+		}
+
+		//Extend the match as far as it goes, stopping before the bytes that have to stay literals
+		size_t matchLength = minMatch;
+		while(i + matchLength < sourceSize_ - lastLiterals && source[candidate + matchLength] == source[i + matchLength]){
+			matchLength++;
+		}
+
+		WriteSequence(output, source + anchor, i - anchor, i - candidate, matchLength);
+		i += matchLength;
+		anchor = i;
+	}
+
+	//Everything left over goes out as literals, the last sequence has no match
+	const size_t literalLength = sourceSize_ - anchor;
+	output.push_back(static_cast<char>(std::min<size_t>(literalLength, 15) << 4));
+	if(literalLength >= 15){
+		WriteLength(output, literalLength - 15);
+	}
+
+	output.insert(output.end(), source_ + anchor, source_ + sourceSize_);
+	return output;
+}
+
+bool Compression::Decompress(const char* source_, size_t sourceSize_, char* destination_, size_t destinationSize_){
+	const unsigned char* source = reinterpret_cast<const unsigned char*>(source_);
+	size_t in = 0;
+	size_t out = 0;
+
+	//Lengths of 15 or more carry on into extra bytes, each 255 means another byte follows
+	auto readLength = [&](size_t& length_){
+		unsigned char extra = 255;
+		while(extra == 255){
+			if(in >= sourceSize_){
+				return false;
+			}
+
+			extra = source[in++];
+			length_ += extra;
+		}
+
+		return true;
+	};
+
+	while(in < sourceSize_){
+		const unsigned char token = source[in++];
+
+		size_t literalLength = token >> 4;
+		if(literalLength == 15 && !readLength(literalLength)){
+			return false;
+		}
+
+		if(literalLength > sourceSize_ - in || literalLength > destinationSize_ - out){
+			return false;
+		}
+
+		memcpy(destination_ + out, source + in, literalLength);
+		in += literalLength;
+		out += literalLength;
+
+		//The last sequence ends after its literals
+		if(in == sourceSize_){
+			break;
+		}
+
+		if(sourceSize_ - in < 2){
+			return false;
+		}
+
+		const size_t offset = static_cast<size_t>(source[in]) | (static_cast<size_t>(source[in + 1]) << 8);
+		in += 2;
+		if(offset == 0 || offset > out){
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if(matchLength == 15 && !readLength(matchLength)){
+			return false;
+		}
+
+		matchLength += minMatch;
+		if(matchLength > destinationSize_ - out){
+			return false;
+		}
+
+		//Matches can overlap the bytes they're producing, so this has to go one byte at a time
+		for(size_t j = 0; j < matchLength; j++){
+			destination_[out + j] = destination_[out - offset + j];
+		}
+
+		out += matchLength;
+	}
+
+	return out == destinationSize_;
+}
+
+void Compression::WriteLength(std::vector<char>& output_, size_t length_){
+	while(length_ >= 255){
+		output_.push_back(static_cast<char>(255));
+		length_ -= 255;
+	}
+
+	output_.push_back(static_cast<char>(length_));
+}
+
+void Compression::WriteSequence(std::vector<char>& output_, const unsigned char* literals_, size_t literalLength_, size_t offset_, size_t matchLength_){
+	const size_t matchCode = matchLength_ - minMatch;
+	output_.push_back(static_cast<char>((std::min<size_t>(literalLength_, 15) << 4) | std::min<size_t>(matchCode, 15)));
+
+	if(literalLength_ >= 15){
+		WriteLength(output_, literalLength_ - 15);
+	}
+
+	output_.insert(output_.end(), literals_, literals_ + literalLength_);
+	output_.push_back(static_cast<char>(offset_ & 0xFF));
+	output_.push_back(static_cast<char>((offset_ >> 8) & 0xFF));
+
+	if(matchCode >= 15){
+		WriteLength(output_, matchCode - 15);
+	}
+}
\ No newline at end of file
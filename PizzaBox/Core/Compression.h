@@ -0,0 +1,35 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace PizzaBox{
+	//Byte compression using the LZ4 block format, which decompresses fast enough to be worth it when reading resources
+	class Compression{
+	public:
+		static std::vector<char> Compress(const char* source_, size_t sourceSize_);
+		//destinationSize_ has to be the exact size of the uncompressed data, returns false if the data is corrupt
+		static bool Decompress(const char* source_, size_t sourceSize_, char* destination_, size_t destinationSize_);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		Compression() = delete;
+		Compression(const Compression&) = delete;
+		Compression(Compression&&) = delete;
+		Compression& operator=(const Compression&) = delete;
+		Compression& operator=(Compression&&) = delete;
+		~Compression() = delete;
+
+	private:
+		static constexpr size_t minMatch = 4;
+		static constexpr size_t maxOffset = 65535;
+		static constexpr size_t lastLiterals = 5; //The format requires the last few bytes to be literals
+		static constexpr size_t matchLimit = 12; //And no match may start this close to the end
+		static constexpr unsigned int hashBits = 16;
+
+		static void WriteLength(std::vector<char>& output_, size_t length_);
+		static void WriteSequence(std::vector<char>& output_, const unsigned char* literals_, size_t literalLength_, size_t offset_, size_t matchLength_);
+	};
+}
+
+#endif //!COMPRESSION_H
\ No newline at end of file
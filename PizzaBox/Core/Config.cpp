@@ -44,6 +44,17 @@ void Config::SetDefaults(){
 	CreateConfigFile("EngineConfig.ini");
 	CreateConfigSection("EngineConfig.ini", "EngineSettings");
 	AddConfig("EngineConfig.ini", "EngineSettings", "MaxAudioChannels", 1024);
+	AddConfig("EngineConfig.ini", "EngineSettings", "CompactSkinnedVertices", false);
+	AddConfig("EngineConfig.ini", "EngineSettings", "PhysicsMaxSubsteps", 8);
+	AddConfig("EngineConfig.ini", "EngineSettings", "PhysicsInterpolation", true);
+	AddConfig("EngineConfig.ini", "EngineSettings", "ThreadedPhysics", false);
+	AddConfig("EngineConfig.ini", "EngineSettings", "CacheCookedColliders", false);
+	AddConfig("EngineConfig.ini", "EngineSettings", "AsyncLoadWorkers", 2);
+	AddConfig("EngineConfig.ini", "EngineSettings", "AsyncFinalizeBudget", 2.0f);
+	AddConfig("EngineConfig.ini", "EngineSettings", "TextureCacheBudget", 256);
+	AddConfig("EngineConfig.ini", "EngineSettings", "ModelCacheBudget", 128);
+	AddConfig("EngineConfig.ini", "EngineSettings", "AudioCacheBudget", 64);
+	AddConfig("EngineConfig.ini", "EngineSettings", "OtherCacheBudget", 16);
 
 	CreateConfigFile("UserConfig.ini");
 	CreateConfigSection("UserConfig.ini", "SystemSettings");
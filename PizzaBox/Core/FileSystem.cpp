@@ -2,18 +2,36 @@
 
 #include <fstream>
 
+#include "MappedFile.h"
+#include "ResourceArchive.h"
 #include "../Tools/Debug.h"
 
 using namespace PizzaBox;
 
 bool FileSystem::Initialize(){
+	//Running without an archive is fine, everything just comes from the loose files instead
+	if(FileExists(ResourceArchive::defaultArchive)){
+		Debug::StartProfiling("Resource Archive Open");
+		const bool opened = ResourceArchive::Open(ResourceArchive::defaultArchive);
+		Debug::EndProfiling("Resource Archive Open");
+
+		if(!opened){
+			Debug::LogWarning("Resource archive couldn't be opened, resources will be read from disk!", __FILE__, __LINE__);
+		}
+	}
+
 	return true;
 }
 
 void FileSystem::Destroy(){
+	ResourceArchive::Close();
 }
 
 bool FileSystem::FileExists(std::string file_){
+	if(ResourceArchive::Contains(file_)){
+		return true;
+	}
+
 	std::fstream filestream;
 	filestream.open(file_, std::ios::in);
 
@@ -27,32 +45,18 @@ bool FileSystem::FileExists(std::string file_){
 std::vector<std::string> FileSystem::ReadFile(std::string file_){
 	std::vector<std::string> fileContents;
 
-	std::fstream filestream;
-	filestream.open(file_, std::ios::in);
-
-	if(!filestream.is_open()){
-		Debug::LogError("Could not open " + file_ + " for reading!", __FILE__, __LINE__);
-		return fileContents;
+	//MappedFile logs its own error if the file can't be opened
+	const MappedFile file(file_);
+	for(const StringView& line : file.Lines()){
+		fileContents.push_back(line.ToString());
 	}
 
-	std::string line;
-	while(std::getline(filestream, line)){
-		fileContents.push_back(line);
-	}
-
-	//Close the file when we're done
-	filestream.close();
 	return fileContents;
 }
 
 std::string FileSystem::ReadFileToString(std::string file_){
-	std::string result;
-	std::vector<std::string> fileContents = ReadFile(file_);
-	for(std::string s : fileContents){
-		result += s + "\n";
-	}
-
-	return result;
+	const MappedFile file(file_);
+	return file.View().ToString();
 }
 
 void FileSystem::WriteToFile(std::string file_, std::string content_, WriteType type_){
@@ -81,27 +85,43 @@ void FileSystem::WriteToFile(std::string file_, std::string content_, WriteType
 	filestream.close();
 }
 
-void FileSystem::ReadRecords(std::string file_, std::map<std::string, std::map<std::string, std::string>>& records_){
+std::vector<char> FileSystem::ReadBinaryFile(std::string file_){
+	const MappedFile file(file_);
+	return std::vector<char>(file.View().begin(), file.View().end());
+}
+
+void FileSystem::WriteBinaryFile(std::string file_, const std::vector<char>& content_){
 	std::fstream filestream;
-	filestream.open(file_, std::ios::in);
+	filestream.open(file_, std::ios::out | std::ios::binary | std::ios_base::trunc);
 
 	if(!filestream.is_open()){
-		Debug::LogError("Could not open " + file_ + " for reading!", __FILE__, __LINE__);
+		Debug::LogError("Could not open " + file_ + " for writing!", __FILE__, __LINE__);
+		return;
+	}
+
+	filestream.write(content_.data(), content_.size());
+	filestream.close();
+}
+
+void FileSystem::ReadRecords(std::string file_, std::map<std::string, std::map<std::string, std::string>>& records_){
+	//MappedFile logs its own error if the file can't be opened
+	const MappedFile file(file_);
+	if(!file.IsOpen()){
 		return;
 	}
 
+	//Lines are only copied where a key, value or section name is needed
 	std::string currentSectionName = "";
-	std::string line;
-	while(std::getline(filestream, line)){
-		if(line.size() >= 1 && line.at(0) == '['){
+	for(const StringView& line : file.Lines()){
+		if(line.size() >= 1 && line[0] == '['){
 			auto first = line.find('[') + 1;
-			auto last = line.find_last_of(']');
-			currentSectionName = line.substr(first, last - first);
+			auto last = line.rfind(']');
+			currentSectionName = line.substr(first, last - first).ToString();
 			records_.insert(std::make_pair(currentSectionName, std::map<std::string, std::string>()));
 		}else if(line.size() >= 1){
 			//Use '=' as a delimeter to get the key and the value from this line
-			std::string key = line.substr(0, line.find('='));
-			std::string value = line.substr(line.find('=') + 1);
+			std::string key = line.substr(0, line.find('=')).ToString();
+			std::string value = line.substr(line.find('=') + 1).ToString();
 
 			for(auto& val : records_){
 				if(val.first == currentSectionName){
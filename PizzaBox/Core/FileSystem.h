@@ -16,6 +16,7 @@ namespace PizzaBox{
 			overwrite
 		};
 
+		//Opens the resource archive if there is one, every read after this checks the archive before the disk
 		static bool Initialize();
 		static void Destroy();
 
@@ -23,6 +24,8 @@ namespace PizzaBox{
 		static std::vector<std::string> ReadFile(std::string file_);
 		static std::string ReadFileToString(std::string file_);
 		static void WriteToFile(std::string file_, std::string content_, WriteType type_ = WriteType::append);
+		static std::vector<char> ReadBinaryFile(std::string file_);
+		static void WriteBinaryFile(std::string file_, const std::vector<char>& content_);
 
 		static void ReadRecords(std::string file_, std::map<std::string, std::map<std::string, std::string>>& records_);
 		static void WriteRecords(std::string file_, const std::map<std::string, std::map<std::string, std::string>>& records_, WriteType type_ = WriteType::clear);
@@ -3,6 +3,7 @@
 #include <rttr/registration.h>
 
 #include "Config.h"
+#include "FileSystem.h"
 #include "SceneManager.h"
 #include "Time.h"
 #include "Animation/AnimEngine.h"
@@ -112,6 +113,12 @@ bool GameManager::Initialize(GameInterface* gameInterface_){
 		return false;
 	}
 
+	//Initialize the FileSystem, this has to happen before anything reads a file so that the resource archive gets used
+	if(FileSystem::Initialize() == false){
+		Debug::DisplayFatalErrorMessage("Initialization Error", "FileSystem could not be initialized!");
+		return false;
+	}
+
 	//Initialize the Configu system
 	if(Config::Initialize() == false){
 		Debug::DisplayFatalErrorMessage("Initialization Error", "Config System could not be initialized!");
@@ -243,6 +250,7 @@ void GameManager::Destroy(){
 	RenderEngine::Destroy();
 	ResourceManager::Destroy();
 	Config::Destroy();
+	FileSystem::Destroy();
 	EngineStats::Destroy();
 	Debug::Destroy();
 
@@ -271,7 +279,10 @@ void GameManager::RunGameLoop(){
 		//This should be the first thing that happens after updating the timer
 		InputManager::PollInput();
 
-		//Update the current scene
+		//Finalize resources that finished loading in the background, within this frame's budget
+		ResourceManager::Update();
+
+		//Change scenes if one was requested
 		//This should be done before any game logic
 		if(SceneManager::Update() == false){
 			//Don't bother doing anything else if something dies here
@@ -290,9 +301,24 @@ void GameManager::RunGameLoop(){
 
 		AnimEngine::Update(Time::DeltaTime());
 
+		//Apply every object, component and hierarchy change recorded this frame, so the next frame starts with all of them in place
+		//This has to come after every system that can record changes, and before a threaded physics step starts
+		//That way bodies that scripts add or remove take part in the very next step, just like they do with serial physics
+		if(SceneManager::LateUpdate() == false){
+			Debug::DisplayFatalErrorMessage("SceneManager Error", "An error has occured while updating the SceneManager!");
+			break;
+		}
+
+		//If physics is threaded, step it while this frame renders
+		PhysicsEngine::StartStep();
+
 		//Render all renderable objects in the current scene and draw the rendered frame to the window
 		//This should be the last thing that happens before delaying the timer
 		RenderEngine::Render();
+
+		//Publish the results of the threaded physics step so that the scene is consistent before the next frame
+		//Collision events published here are queued, so they're still delivered to scripts next frame
+		PhysicsEngine::FinishStep();
 		
 		//Stop measuring the length of the game loop before the Timer delay
 		Debug::EndProfiling("Main Game Loop");
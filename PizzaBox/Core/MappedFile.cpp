@@ -0,0 +1,167 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif //_WIN32
+
+#include "ResourceArchive.h"
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+MappedFile::MappedFile() : contents(), buffer(), isOpen(false), mapping(nullptr), mappingSize(0)
+	#ifdef _WIN32
+	, mappingHandle(nullptr)
+	#endif //_WIN32
+{
+}
+
+MappedFile::MappedFile(const std::string& file_) : MappedFile(){
+	Open(file_);
+}
+
+MappedFile::~MappedFile(){
+	Release();
+}
+
+MappedFile::MappedFile(MappedFile&& other_) : MappedFile(){
+	MoveFrom(other_);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other_){
+	if(this != &other_){
+		Release();
+		MoveFrom(other_);
+	}
+
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& file_){
+	Release();
+
+	if(ResourceArchive::OpenEntry(file_, contents, buffer)){
+		isOpen = true;
+		return true;
+	}
+
+	return OpenFromDisk(file_);
+}
+
+bool MappedFile::OpenFromDisk(const std::string& file_){
+	Release();
+
+	#ifdef _WIN32
+	HANDLE file = CreateFileA(file_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(file == INVALID_HANDLE_VALUE){
+		Debug::LogError("Could not open " + file_ + " for reading!", __FILE__, __LINE__);
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if(GetFileSizeEx(file, &fileSize) == FALSE){
+		Debug::LogError("Could not get the size of " + file_ + "!", __FILE__, __LINE__);
+		CloseHandle(file);
+		return false;
+	}
+
+	mappingSize = static_cast<size_t>(fileSize.QuadPart);
+	//Empty files can't be mapped, but there's nothing to read from them anyway
+	if(mappingSize > 0){
+		mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mappingHandle != nullptr){
+			mapping = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		}
+	}
+
+	//The mapping keeps the file open on its own
+	CloseHandle(file);
+	#else
+	const int file = open(file_.c_str(), O_RDONLY);
+	if(file < 0){
+		Debug::LogError("Could not open " + file_ + " for reading!", __FILE__, __LINE__);
+		return false;
+	}
+
+	struct stat fileStats;
+	if(fstat(file, &fileStats) != 0){
+		Debug::LogError("Could not get the size of " + file_ + "!", __FILE__, __LINE__);
+		close(file);
+		return false;
+	}
+
+	mappingSize = static_cast<size_t>(fileStats.st_size);
+	//Empty files can't be mapped, but there's nothing to read from them anyway
+	if(mappingSize > 0){
+		mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+		if(mapping == MAP_FAILED){
+			mapping = nullptr;
+		}
+	}
+
+	//The mapping keeps the file open on its own
+	close(file);
+	#endif //_WIN32
+
+	if(mappingSize > 0 && mapping == nullptr){
+		Debug::LogError("Could not map " + file_ + " into memory!", __FILE__, __LINE__);
+		Release();
+		return false;
+	}
+
+	contents = StringView(static_cast<const char*>(mapping), mappingSize);
+	isOpen = true;
+	return true;
+}
+
+void MappedFile::Close(){
+	Release();
+}
+
+void MappedFile::Release(){
+	#ifdef _WIN32
+	if(mapping != nullptr){
+		UnmapViewOfFile(mapping);
+	}
+
+	if(mappingHandle != nullptr){
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+	}
+	#else
+	if(mapping != nullptr){
+		munmap(mapping, mappingSize);
+	}
+	#endif //_WIN32
+
+	mapping = nullptr;
+	mappingSize = 0;
+	contents = StringView();
+	buffer.clear();
+	buffer.shrink_to_fit();
+	isOpen = false;
+}
+
+void MappedFile::MoveFrom(MappedFile& other_){
+	//Moving the buffer keeps its storage where it was, so a view into it stays valid
+	contents = other_.contents;
+	buffer = std::move(other_.buffer);
+	isOpen = other_.isOpen;
+	mapping = other_.mapping;
+	mappingSize = other_.mappingSize;
+	#ifdef _WIN32
+	mappingHandle = other_.mappingHandle;
+	other_.mappingHandle = nullptr;
+	#endif //_WIN32
+
+	other_.contents = StringView();
+	other_.isOpen = false;
+	other_.mapping = nullptr;
+	other_.mappingSize = 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+
+#include "StringView.h"
+
+namespace PizzaBox{
+	//A read-only view of a whole file, mapped into memory instead of copied out of it
+	//Files in the resource archive are viewed straight out of the archive's mapping, unless they had to be decompressed
+	class MappedFile{
+	public:
+		MappedFile();
+		explicit MappedFile(const std::string& file_);
+		~MappedFile();
+
+		MappedFile(MappedFile&& other_);
+		MappedFile& operator=(MappedFile&& other_);
+
+		//Checks the resource archive before the disk
+		bool Open(const std::string& file_);
+		//Skips the resource archive, which is how the archive maps itself
+		bool OpenFromDisk(const std::string& file_);
+		void Close();
+
+		inline bool IsOpen() const{ return isOpen; }
+		inline const char* Data() const{ return contents.data(); }
+		inline size_t Size() const{ return contents.size(); }
+		//Only valid for as long as this MappedFile stays open
+		inline StringView View() const{ return contents; }
+		inline LineRange Lines() const{ return contents.Lines(); }
+
+		//Delete unwanted compiler generated constructors and assignment operators
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	private:
+		StringView contents;
+		std::vector<char> buffer; //Holds the contents when they had to be decompressed out of the archive
+		bool isOpen;
+
+		void* mapping; //The start of the mapped view, nullptr if nothing from disk is mapped
+		size_t mappingSize;
+		#ifdef _WIN32
+		void* mappingHandle;
+		#endif //_WIN32
+
+		void Release();
+		void MoveFrom(MappedFile& other_);
+	};
+}
+
+#endif //!MAPPED_FILE_H
\ No newline at end of file
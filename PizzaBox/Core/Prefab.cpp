@@ -0,0 +1,151 @@
+#include "Prefab.h"
+
+#include <typeinfo>
+
+#include <rttr/registration.h>
+
+#include "Scene.h"
+#include "Object/GameObject.h"
+#include "Object/TagTable.h"
+#include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
+
+using namespace PizzaBox;
+
+//Suppress meaningless and unavoidable warning
+#pragma warning( push )
+#pragma warning( disable : 26444 )
+RTTR_REGISTRATION{
+	rttr::registration::class_<Prefab>("Prefab")
+		.constructor()
+		.method("Capture", &Prefab::Capture)
+		.method("Release", &Prefab::Release)
+		.method("Instantiate", static_cast<GameObject*(Prefab::*)(Scene*, const Vector3&, const Euler&, const Vector3&, GameObject*) const>(&Prefab::Instantiate))
+		.method("IsEmpty", &Prefab::IsEmpty);
+}
+#pragma warning( pop )
+
+Prefab::Node::~Node(){
+	for(Component* c : components){
+		//Copies hold references to resources even though they were never initialized, Destroy lets them go
+		c->Destroy();
+		delete c;
+	}
+
+	for(Node* child : children){
+		delete child;
+	}
+
+	components.clear();
+	children.clear();
+}
+
+Prefab::Prefab() : root(nullptr){
+}
+
+Prefab::~Prefab(){
+	Release();
+}
+
+bool Prefab::Capture(GameObject* source_){
+	_ASSERT(source_ != nullptr);
+
+	Release();
+
+	bool isComplete = true;
+	root = CaptureNode(source_, isComplete);
+	return isComplete;
+}
+
+void Prefab::Release(){
+	if(root != nullptr){
+		delete root;
+		root = nullptr;
+	}
+}
+
+GameObject* Prefab::Instantiate(Scene* scene_, const Vector3& pos_, const Euler& rot_, const Vector3& scale_, GameObject* parent_) const{
+	const std::vector<GameObject*> objects = Instantiate(scene_, std::vector<Vector3>{ pos_ }, std::vector<Euler>{ rot_ }, std::vector<Vector3>{ scale_ }, parent_);
+	if(objects.empty()){
+		return nullptr;
+	}
+
+	return objects.front();
+}
+
+std::vector<GameObject*> Prefab::Instantiate(Scene* scene_, const std::vector<Vector3>& positions_, const std::vector<Euler>& rotations_, const std::vector<Vector3>& scales_, GameObject* parent_) const{
+	_ASSERT(scene_ != nullptr);
+
+	if(root == nullptr){
+		Debug::LogWarning("Tried to instantiate a prefab that hasn't captured anything!", __FILE__, __LINE__);
+		return std::vector<GameObject*>();
+	}
+
+	Debug::StartProfiling("Prefab Instantiate");
+	std::vector<GameObject*> objects = scene_->SpawnObjects(Description(), positions_, rotations_, scales_, parent_);
+	Debug::EndProfiling("Prefab Instantiate");
+
+	EngineStats::AddToInt("Prefab Instances", static_cast<long long>(objects.size()));
+	return objects;
+}
+
+PrefabDescription Prefab::Description() const{
+	_ASSERT(root != nullptr);
+
+	const Node* node = root;
+	PrefabDescription description = PrefabDescription([node](GameObject* go_){
+		BuildContents(node, go_);
+	});
+
+	description.isStatic = root->isStatic;
+	description.tags.reserve(root->tags.size());
+	for(unsigned int tag : root->tags){
+		description.tags.push_back(TagTable::GetTagName(tag));
+	}
+
+	return description;
+}
+
+Prefab::Node* Prefab::CaptureNode(GameObject* source_, bool& isComplete_){
+	Node* node = new Node(source_->GetPosition(), source_->GetRotation(), source_->GetScale());
+	node->isStatic = source_->IsStatic();
+	node->tags = source_->GetTags();
+
+	for(Component* c : source_->GetComponents<Component>()){
+		Component* copy = c->Clone();
+		if(copy == nullptr){
+			Debug::LogWarning(std::string("Prefab couldn't copy a component of type ") + typeid(*c).name() + "!", __FILE__, __LINE__);
+			isComplete_ = false;
+			continue;
+		}
+
+		node->components.push_back(copy);
+	}
+
+	node->children.reserve(source_->GetChildren().size());
+	for(GameObject* child : source_->GetChildren()){
+		node->children.push_back(CaptureNode(child, isComplete_));
+	}
+
+	return node;
+}
+
+void Prefab::BuildContents(const Node* node_, GameObject* go_){
+	_ASSERT(node_ != nullptr);
+	_ASSERT(go_ != nullptr);
+
+	for(const Component* c : node_->components){
+		go_->AddComponent(c->Clone());
+	}
+
+	for(const Node* childNode : node_->children){
+		GameObject* child = new GameObject(childNode->position, childNode->rotation, childNode->scale);
+		child->SetStatic(childNode->isStatic);
+		for(unsigned int tag : childNode->tags){
+			child->SetTag(tag);
+		}
+
+		BuildContents(childNode, child);
+		go_->AddChild(child);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Math/Euler.h"
+#include "Math/Vector.h"
+
+namespace PizzaBox{
+	class Component;
+	class GameObject;
+	class Scene;
+
+	//Describes what every object in a spawned batch should look like
+	struct PrefabDescription{
+		PrefabDescription(const std::function<void(GameObject*)>& build_ = nullptr) : build(build_), tags(), isStatic(false){}
+
+		std::function<void(GameObject*)> build; //Adds the components and children each object needs
+		std::vector<std::string> tags;
+		bool isStatic;
+	};
+
+	//A template captured from a GameObject and everything under it, which can be instantiated as many times as needed
+	//The template holds its own references to the resources the original used, so instances share them without looking them up by name
+	class Prefab{
+	public:
+		Prefab();
+		~Prefab();
+
+		//Copies the settings of source_'s components and children, replacing whatever was captured before
+		//Returns false if any component couldn't be copied, everything else is still captured
+		bool Capture(GameObject* source_);
+		void Release();
+
+		GameObject* Instantiate(Scene* scene_, const Vector3& pos_ = Vector3(), const Euler& rot_ = Euler(), const Vector3& scale_ = Vector3(1.0f, 1.0f, 1.0f), GameObject* parent_ = nullptr) const;
+		std::vector<GameObject*> Instantiate(Scene* scene_, const std::vector<Vector3>& positions_, const std::vector<Euler>& rotations_ = std::vector<Euler>(), const std::vector<Vector3>& scales_ = std::vector<Vector3>(), GameObject* parent_ = nullptr) const;
+
+		//Lets this prefab be used with Scene::SpawnObjects, the prefab has to outlive the call
+		PrefabDescription Description() const;
+
+		inline bool IsEmpty() const{ return root == nullptr; }
+
+		//Delete unwanted compiler generated constructors and assignment operators
+		Prefab(const Prefab&) = delete;
+		Prefab(Prefab&&) = delete;
+		Prefab& operator=(const Prefab&) = delete;
+		Prefab& operator=(Prefab&&) = delete;
+
+	private:
+		struct Node{
+			Node(const Vector3& position_, const Euler& rotation_, const Vector3& scale_) : position(position_), rotation(rotation_), scale(scale_), isStatic(false), tags(), components(), children(){}
+			~Node();
+
+			Vector3 position;
+			Euler rotation;
+			Vector3 scale;
+			bool isStatic;
+			std::vector<unsigned int> tags;
+			std::vector<Component*> components; //Uninitialized copies, instances get copies of these
+			std::vector<Node*> children;
+		};
+
+		Node* root;
+
+		static Node* CaptureNode(GameObject* source_, bool& isComplete_);
+		//Adds copies of the node's components and children to go_
+		static void BuildContents(const Node* node_, GameObject* go_);
+	};
+}
+
+#endif //!PREFAB_H
\ No newline at end of file
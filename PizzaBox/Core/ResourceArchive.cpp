@@ -0,0 +1,298 @@
+#include "ResourceArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <experimental/filesystem>
+#include <fstream>
+
+#include "Compression.h"
+#include "MappedFile.h"
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+//Initialize static variables here
+const std::string ResourceArchive::defaultArchive = "Resources.pak";
+constexpr uint32_t ResourceArchive::version;
+constexpr uint32_t ResourceArchive::compressedFlag;
+bool ResourceArchive::isOpen = false;
+MappedFile ResourceArchive::archive;
+const ResourceArchive::Entry* ResourceArchive::entries = nullptr;
+size_t ResourceArchive::entryCount = 0;
+StringView ResourceArchive::names;
+
+namespace{
+	const char archiveMagic[4] = { 'P', 'Z', 'A', 'R' };
+}
+
+bool ResourceArchive::Open(const std::string& archiveFile_){
+	Close();
+
+	if(archive.OpenFromDisk(archiveFile_) == false){
+		Debug::LogError("Could not open resource archive " + archiveFile_ + "!", __FILE__, __LINE__);
+		return false;
+	}
+
+	Header header;
+	if(archive.Size() < sizeof(header)){
+		Debug::LogError(archiveFile_ + " is not a resource archive!", __FILE__, __LINE__);
+		archive.Close();
+		return false;
+	}
+
+	memcpy(&header, archive.Data(), sizeof(header));
+	if(memcmp(header.magic, archiveMagic, sizeof(archiveMagic)) != 0 || header.version != version){
+		Debug::LogError(archiveFile_ + " is not a resource archive, or was packed by a different version of the engine!", __FILE__, __LINE__);
+		archive.Close();
+		return false;
+	}
+
+	if(sizeof(Header) + (sizeof(Entry) * static_cast<uint64_t>(header.entryCount)) > archive.Size() || header.namesOffset + header.namesSize > archive.Size()){
+		Debug::LogError("Resource archive " + archiveFile_ + " is truncated!", __FILE__, __LINE__);
+		archive.Close();
+		return false;
+	}
+
+	//The index comes straight after the header, and mappings start on a page boundary, so it's aligned well enough to use in place
+	entries = reinterpret_cast<const Entry*>(archive.Data() + sizeof(Header));
+	entryCount = header.entryCount;
+	names = archive.View().substr(static_cast<size_t>(header.namesOffset), static_cast<size_t>(header.namesSize));
+
+	isOpen = true;
+	Debug::Log("Opened resource archive " + archiveFile_ + " with " + std::to_string(entryCount) + " entries", __FILE__, __LINE__);
+	return true;
+}
+
+void ResourceArchive::Close(){
+	isOpen = false;
+	entries = nullptr;
+	entryCount = 0;
+	names = StringView();
+	archive.Close();
+}
+
+bool ResourceArchive::Contains(const std::string& file_){
+	return FindEntry(file_) != nullptr;
+}
+
+bool ResourceArchive::OpenEntry(const std::string& file_, StringView& contents_, std::vector<char>& buffer_){
+	const Entry* entry = FindEntry(file_);
+	if(entry == nullptr){
+		return false;
+	}
+
+	if(entry->offset + entry->storedSize > archive.Size()){
+		Debug::LogError("Could not read " + file_ + " from the resource archive!", __FILE__, __LINE__);
+		return false;
+	}
+
+	const StringView stored = archive.View().substr(static_cast<size_t>(entry->offset), static_cast<size_t>(entry->storedSize));
+	if((entry->flags & compressedFlag) == 0){
+		contents_ = stored;
+		return true;
+	}
+
+	buffer_.resize(static_cast<size_t>(entry->size));
+	if(Compression::Decompress(stored.data(), stored.size(), buffer_.data(), buffer_.size()) == false){
+		Debug::LogError(file_ + " is corrupt in the resource archive!", __FILE__, __LINE__);
+		buffer_.clear();
+		return false;
+	}
+
+	contents_ = StringView(buffer_.data(), buffer_.size());
+	return true;
+}
+
+bool ResourceArchive::ReadEntry(const std::string& file_, std::vector<char>& contents_){
+	StringView view;
+	std::vector<char> buffer;
+	if(OpenEntry(file_, view, buffer) == false){
+		return false;
+	}
+
+	//Decompressed entries are already a copy of their own
+	if(!buffer.empty()){
+		contents_.swap(buffer);
+	}else{
+		contents_.assign(view.begin(), view.end());
+	}
+
+	return true;
+}
+
+bool ResourceArchive::Pack(const std::string& sourceDirectory_, const std::string& archiveFile_, bool compress_, unsigned int alignment_){
+	namespace fs = std::experimental::filesystem;
+	alignment_ = std::max(alignment_, 1u);
+
+	std::error_code error;
+	if(!fs::is_directory(sourceDirectory_, error)){
+		Debug::LogError(sourceDirectory_ + " is not a directory!", __FILE__, __LINE__);
+		return false;
+	}
+
+	//Any file that can't be read fails the whole pack, a partial archive would hide the missing files until something tried to load them
+	std::vector<std::string> files;
+	const fs::recursive_directory_iterator end;
+	for(fs::recursive_directory_iterator item(sourceDirectory_, error); !error && item != end; item.increment(error)){
+		const fs::file_status status = item->status(error);
+		if(error){
+			break;
+		}
+
+		//Don't pack an old copy of the archive into the new one, there's no old copy if comparing them fails
+		std::error_code archiveError;
+		if(fs::is_regular_file(status) && !fs::equivalent(item->path(), archiveFile_, archiveError)){
+			files.push_back(item->path().generic_string());
+		}
+	}
+
+	if(error){
+		Debug::LogError("Could not read " + sourceDirectory_ + "! " + error.message(), __FILE__, __LINE__);
+		return false;
+	}
+
+	std::vector<Entry> packedEntries;
+	std::vector<std::vector<char>> packedData;
+	std::string packedNames;
+	packedEntries.reserve(files.size());
+	packedData.reserve(files.size());
+
+	uint64_t totalSize = 0;
+	for(const std::string& file : files){
+		//Read straight from the disk, an empty result from ReadBinaryFile can't be told apart from a file that couldn't be read
+		MappedFile source;
+		if(source.OpenFromDisk(file) == false){
+			Debug::LogError("Could not pack " + file + "!", __FILE__, __LINE__);
+			return false;
+		}
+
+		std::vector<char> contents = std::vector<char>(source.View().begin(), source.View().end());
+		source.Close();
+		const std::string name = NormalizePath(file);
+
+		Entry entry;
+		entry.hash = Hash(name);
+		entry.offset = 0;
+		entry.size = contents.size();
+		entry.nameOffset = static_cast<uint32_t>(packedNames.size());
+		entry.nameLength = static_cast<uint32_t>(name.size());
+		entry.flags = 0;
+		entry.reserved = 0;
+		packedNames += name;
+		totalSize += contents.size();
+
+		//Images and sounds are usually compressed already, so only keep the compressed copy if it saves at least an eighth
+		if(compress_ && !contents.empty()){
+			std::vector<char> compressed = Compression::Compress(contents.data(), contents.size());
+			if(compressed.size() < contents.size() - (contents.size() / 8)){
+				contents.swap(compressed);
+				entry.flags |= compressedFlag;
+			}
+		}
+
+		entry.storedSize = contents.size();
+		packedEntries.push_back(entry);
+		packedData.push_back(std::move(contents));
+	}
+
+	//Sort the index by hash, keeping each entry's data with it
+	std::vector<size_t> order(packedEntries.size());
+	for(size_t i = 0; i < order.size(); i++){
+		order[i] = i;
+	}
+
+	std::sort(order.begin(), order.end(), [&](size_t a_, size_t b_){ return packedEntries[a_].hash < packedEntries[b_].hash; });
+
+	auto align = [alignment_](uint64_t offset_){ return ((offset_ + alignment_ - 1) / alignment_) * alignment_; };
+
+	Header header;
+	memcpy(header.magic, archiveMagic, sizeof(archiveMagic));
+	header.version = version;
+	header.entryCount = static_cast<uint32_t>(packedEntries.size());
+	header.alignment = alignment_;
+	header.namesOffset = sizeof(Header) + (sizeof(Entry) * packedEntries.size());
+	header.namesSize = packedNames.size();
+
+	std::vector<Entry> index;
+	index.reserve(order.size());
+	uint64_t offset = align(header.namesOffset + header.namesSize);
+	for(size_t i : order){
+		Entry entry = packedEntries[i];
+		entry.offset = offset;
+		offset = align(offset + entry.storedSize);
+		index.push_back(entry);
+	}
+
+	std::ofstream output(archiveFile_, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!output.is_open()){
+		Debug::LogError("Could not open " + archiveFile_ + " for writing!", __FILE__, __LINE__);
+		return false;
+	}
+
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(index.data()), sizeof(Entry) * index.size());
+	output.write(packedNames.data(), packedNames.size());
+
+	const std::vector<char> padding(alignment_, 0);
+	uint64_t written = header.namesOffset + header.namesSize;
+	for(size_t i = 0; i < order.size(); i++){
+		output.write(padding.data(), static_cast<std::streamsize>(index[i].offset - written));
+		output.write(packedData[order[i]].data(), packedData[order[i]].size());
+		written = index[i].offset + index[i].storedSize;
+	}
+
+	if(!output){
+		Debug::LogError("Could not write " + archiveFile_ + "!", __FILE__, __LINE__);
+		return false;
+	}
+
+	Debug::Log("Packed " + std::to_string(index.size()) + " files from " + sourceDirectory_ + " into " + archiveFile_ + ", " +
+		std::to_string(totalSize) + " bytes down to " + std::to_string(written) + " bytes", __FILE__, __LINE__
+	);
+	return true;
+}
+
+std::string ResourceArchive::NormalizePath(const std::string& file_){
+	std::string path;
+	path.reserve(file_.size());
+	std::transform(file_.begin(), file_.end(), std::back_inserter(path), [](char c_){
+		return (c_ == '\\') ? '/' : static_cast<char>(tolower(c_));
+	});
+
+	while(path.compare(0, 2, "./") == 0){
+		path.erase(0, 2);
+	}
+
+	return path;
+}
+
+uint64_t ResourceArchive::Hash(const std::string& path_){
+	//64 bit FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : path_){
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+const ResourceArchive::Entry* ResourceArchive::FindEntry(const std::string& file_){
+	if(!isOpen){
+		return nullptr;
+	}
+
+	const std::string name = NormalizePath(file_);
+	const uint64_t hash = Hash(name);
+
+	const Entry* end = entries + entryCount;
+	const Entry* entry = std::lower_bound(entries, end, hash, [](const Entry& entry_, uint64_t hash_){ return entry_.hash < hash_; });
+	//Different paths can share a hash, so check the names too
+	for(; entry != end && entry->hash == hash; ++entry){
+		if(names.substr(entry->nameOffset, entry->nameLength) == StringView(name)){
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
\ No newline at end of file
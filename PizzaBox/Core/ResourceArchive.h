@@ -0,0 +1,81 @@
+#ifndef RESOURCE_ARCHIVE_H
+#define RESOURCE_ARCHIVE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace PizzaBox{
+	//Packs every resource into one file, so that loading them doesn't need to open hundreds of files
+	//Entries are found through an index sorted by the hash of their path, and each one can be compressed on its own
+	//The archive is mapped into memory, so the index is used where it is and uncompressed entries are never copied
+	class ResourceArchive{
+	public:
+		static const std::string defaultArchive;
+
+		//Files in the archive are read from there from now on, anything that isn't in it is still read from disk
+		static bool Open(const std::string& archiveFile_);
+		static void Close();
+		inline static bool IsOpen(){ return isOpen; }
+
+		static bool Contains(const std::string& file_);
+		//Returns false if the file isn't in the archive, or if the archive is closed
+		//Uncompressed entries are viewed straight out of the mapping, compressed ones are decompressed into buffer_ and viewed there
+		//Both are safe to call from the worker threads that decode resources, since the mapping is never written to
+		static bool OpenEntry(const std::string& file_, StringView& contents_, std::vector<char>& buffer_);
+		//Copies the entry, for anything that needs to own its data
+		static bool ReadEntry(const std::string& file_, std::vector<char>& contents_);
+
+		//Packs every file under sourceDirectory_, their paths are stored the same way they'd be opened from the working directory
+		//Entries are only compressed when that makes them noticeably smaller, and every entry starts on a multiple of alignment_
+		static bool Pack(const std::string& sourceDirectory_, const std::string& archiveFile_, bool compress_ = true, unsigned int alignment_ = 16);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		ResourceArchive() = delete;
+		ResourceArchive(const ResourceArchive&) = delete;
+		ResourceArchive(ResourceArchive&&) = delete;
+		ResourceArchive& operator=(const ResourceArchive&) = delete;
+		ResourceArchive& operator=(ResourceArchive&&) = delete;
+		~ResourceArchive() = delete;
+
+	private:
+		//The file starts with the header, followed by the index, the names of every entry and then the entries themselves
+		struct Header{
+			char magic[4];
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t alignment;
+			uint64_t namesOffset;
+			uint64_t namesSize;
+		};
+
+		struct Entry{
+			uint64_t hash;
+			uint64_t offset;
+			uint64_t storedSize; //Size in the archive, which is smaller than size if the entry is compressed
+			uint64_t size;
+			uint32_t nameOffset;
+			uint32_t nameLength;
+			uint32_t flags;
+			uint32_t reserved;
+		};
+
+		static constexpr uint32_t version = 1;
+		static constexpr uint32_t compressedFlag = 1;
+
+		static bool isOpen;
+		static MappedFile archive;
+		static const Entry* entries; //Sorted by hash, points into the mapping
+		static size_t entryCount;
+		static StringView names;
+
+		//Paths are stored lower case with forward slashes, so the same file is found however it was written
+		static std::string NormalizePath(const std::string& file_);
+		static uint64_t Hash(const std::string& path_);
+		static const Entry* FindEntry(const std::string& file_);
+	};
+}
+
+#endif //!RESOURCE_ARCHIVE_H
\ No newline at end of file
@@ -1,12 +1,25 @@
 #include "Scene.h"
 
+#include <unordered_set>
+
 #include <rttr/registration.h>
 
 #include "GameManager.h"
+#include "Graphics/RenderEngine.h"
+#include "Graphics/Models/MeshRender.h"
+#include "Graphics/Models/ModelLoader.h"
+#include "Object/TagTable.h"
+#include "Physics/Collider.h"
+#include "Physics/PhysicsEngine.h"
+#include "Physics/Rigidbody.h"
 #include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
 
 using namespace PizzaBox;
 
+//Initialize static variables here
+constexpr size_t Scene::notInScene;
+
 //Suppress meaningless and unavoidable warning
 #pragma warning( push )
 #pragma warning( disable : 26444 )
@@ -19,20 +32,20 @@ RTTR_REGISTRATION{
 		.method("DestroyObject", &Scene::DestroyObject)
 		.method("AttachObject", &Scene::AttachObject)
 		.method("DetachObject", &Scene::DetachObject)
-		.method("FindWithTag", &Scene::FindWithTag)
+		.method("FindWithTag", static_cast<GameObject*(Scene::*)(const std::string&)>(&Scene::FindWithTag))
 		.method("FindObjectsWithTag", &Scene::FindObjectsWithTag)
 		.method("GetSky", &Scene::GetSky)
 		.method("SetSky", &Scene::SetSky);
 }
 #pragma warning( pop )
 
-Scene::Scene() : gameObjectList(std::vector<GameObject*>()), sky(nullptr), createQueue(std::queue<GameObject*>()), destroyQueue(std::queue<GameObject*>()), skyQueue(std::queue<Sky*>()){
+Scene::Scene() : gameObjectList(std::vector<GameObject*>()), sky(nullptr), commands(), batches(), skyQueue(std::queue<Sky*>()), allComponents(), componentRegistries(), tagIndex(){
 }
 
 Scene::~Scene(){
 	//This shouldn't be necessary but in Debug mode we'll do it anyway just to be safe and avoid memory leaks
 #ifdef _DEBUG
-	if(!gameObjectList.empty() || sky != nullptr || !createQueue.empty() || !destroyQueue.empty() || !skyQueue.empty()){
+	if(!gameObjectList.empty() || sky != nullptr || !commands.empty() || !skyQueue.empty()){
 		Debug::LogWarning("Memory leak detected in Scene!", __FILE__, __LINE__);
 		Debug::LogWarning("Make sure you call Scene::Destroy, or don't override Destroy if it doesn't do anything.");
 		Scene::Destroy();
@@ -52,25 +65,28 @@ void Scene::Destroy(){
 	gameObjectList.clear();
 	gameObjectList.shrink_to_fit();
 
+	allComponents.Clear();
+	componentRegistries.clear();
+	componentRegistries.shrink_to_fit();
+	tagIndex.clear();
+	tagIndex.shrink_to_fit();
+
 	if(sky != nullptr){
 		sky->Destroy();
 		delete sky;
 		sky = nullptr;
 	}
 
-	while(!createQueue.empty()){
-		if(createQueue.front() != nullptr){
-			createQueue.front()->Destroy();
-			delete createQueue.front();
-			createQueue.pop();
-		}
+	//Anything these commands were going to add hasn't been attached to an object yet, so it has to be deleted here
+	//Objects they were going to change or remove will have already been deleted in the gameObjectList
+	for(size_t i = 0; i < commands.size(); i++){
+		ReleaseCommand(commands[i]);
 	}
 
-	while(!destroyQueue.empty()){
-		//Objects in the destroyQueue will have already been deleted in the gameObjectList
-		//Attempting to delete them again here would cause memory corruption
-		destroyQueue.pop();
-	}
+	commands.clear();
+	commands.shrink_to_fit();
+	batches.clear();
+	batches.shrink_to_fit();
 
 	while(!skyQueue.empty()){
 		skyQueue.front()->Destroy();
@@ -80,20 +96,8 @@ void Scene::Destroy(){
 }
 
 bool Scene::Update(){
-	if(MaintainQueues() == false){
-		Debug::LogError("Scene Queue Maintenance Error!", __FILE__, __LINE__);
-		return false;
-	}
-
-	for(GameObject* go : gameObjectList){
-		if(go->Update() == false){
-			Debug::LogError("GameObject could not be updated!", __FILE__, __LINE__);
-			return false;
-		}
-	}
-
-	if(MaintainQueues() == false){
-		Debug::LogError("Scene Queue Maintenance Error!", __FILE__, __LINE__);
+	if(ApplyCommands() == false){
+		Debug::LogError("Scene Command Error!", __FILE__, __LINE__);
 		return false;
 	}
 
@@ -103,37 +107,113 @@ bool Scene::Update(){
 void Scene::DestroyObject(GameObject* go_){
 	//Must be a valid GameObject pointer
 	_ASSERT(go_ != nullptr);
-	destroyQueue.push(go_);
+	RecordCommand(SceneCommandType::DestroyObject, go_);
+}
+
+void Scene::DestroyObjects(const std::vector<GameObject*>& objects_){
+	if(objects_.empty()){
+		return;
+	}
+
+	RecordBatchCommand(SceneCommandType::DestroyObjects, std::vector<GameObject*>(objects_));
 }
 
 void Scene::AttachObject(GameObject* go_){
-	attachQueue.push(go_);
+	_ASSERT(go_ != nullptr);
+	RecordCommand(SceneCommandType::AttachObject, go_);
 }
 
 void Scene::DetachObject(GameObject* go_){
-	detachQueue.push(go_);
+	_ASSERT(go_ != nullptr);
+	RecordCommand(SceneCommandType::DetachObject, go_);
+}
+
+void Scene::RecordCommand(SceneCommandType type_, GameObject* target_, GameObject* object_, Component* component_){
+	_ASSERT(target_ != nullptr);
+	commands.push_back(SceneCommand(type_, target_, object_, component_));
 }
 
 GameObject* Scene::FindWithTag(const std::string& tag_){
-	for(GameObject* go : gameObjectList){
-		if(go->HasTag(tag_)){
-			return go;
-		}
+	unsigned int tag = 0;
+	if(!TagTable::FindTag(tag_, tag)){
+		return nullptr;
 	}
 
-	return nullptr;
+	return FindWithTag(tag);
+}
+
+GameObject* Scene::FindWithTag(unsigned int tag_){
+	//Only one object is needed, so look straight in the index instead of copying the whole list
+	if(tag_ >= tagIndex.size() || tagIndex[tag_].items.empty()){
+		return nullptr;
+	}
+
+	return tagIndex[tag_].items.front();
 }
 
 std::vector<GameObject*> Scene::FindObjectsWithTag(const std::string& tag_){
-	std::vector<GameObject*> objectsWithTag;
+	return FindAllWithTag(tag_);
+}
 
-	for(GameObject* go : gameObjectList){
-		if(go->HasTag(tag_)){
-			objectsWithTag.push_back(go);
+std::vector<GameObject*> Scene::FindAllWithTag(const std::string& tag_){
+	unsigned int tag = 0;
+	if(!TagTable::FindTag(tag_, tag)){
+		//Nothing has ever used this tag, so don't bother adding it to the table
+		return std::vector<GameObject*>();
+	}
+
+	return FindAllWithTag(tag);
+}
+
+std::vector<GameObject*> Scene::FindAllWithTag(unsigned int tag_){
+	if(tag_ >= tagIndex.size()){
+		return std::vector<GameObject*>();
+	}
+
+	return tagIndex[tag_].items;
+}
+
+void Scene::RegisterTag(GameObject* go_, unsigned int tag_){
+	_ASSERT(go_ != nullptr);
+	if(tag_ >= tagIndex.size()){
+		tagIndex.resize(tag_ + 1);
+	}
+
+	tagIndex[tag_].Add(go_);
+}
+
+void Scene::UnregisterTag(GameObject* go_, unsigned int tag_){
+	_ASSERT(go_ != nullptr);
+	if(tag_ < tagIndex.size()){
+		tagIndex[tag_].Remove(go_);
+	}
+}
+
+void Scene::RegisterComponent(Component* component_){
+	_ASSERT(component_ != nullptr);
+	if(allComponents.Contains(component_)){
+		return;
+	}
+
+	allComponents.Add(component_);
+	const ComponentTypeID::Mask& mask = ComponentTypeID::MaskOf(component_);
+	for(size_t i = 0; i < componentRegistries.size() && i < ComponentTypeID::maxTypes; i++){
+		if(componentRegistries[i].isTracked && mask.test(i)){
+			componentRegistries[i].components.Add(component_);
 		}
 	}
+}
+
+void Scene::UnregisterComponent(Component* component_){
+	_ASSERT(component_ != nullptr);
+	if(!allComponents.Contains(component_)){
+		return;
+	}
 
-	return objectsWithTag;
+	allComponents.Remove(component_);
+	for(ComponentRegistry& registry : componentRegistries){
+		registry.components.Remove(component_);
+	}
 }
 
 Sky* Scene::GetSky(){
@@ -145,32 +225,42 @@ void Scene::SetSky(Sky* sky_){
 	skyQueue.push(sky_);
 }
 
-bool Scene::MaintainQueues(){
-	//Create any objects that are set to be created
-	while(!createQueue.empty()){
-		_ASSERT(createQueue.front() != nullptr);
-		GameObject* go = createQueue.front();
-		createQueue.pop();
+bool Scene::ApplyCommands(){
+	//Objects created in the same batch often share model files, so let them share the imports as well
+	ModelLoader::ImportScope importScope;
+
+	//Applying a command can record more of them (a child's Initialize adding components for example)
+	//Those get applied in the same pass, so by the end of this the hierarchy is completely up to date
+	const size_t recordedCommands = commands.size();
+	for(size_t i = 0; i < commands.size(); i++){
+		//Copy the command since the list can grow while it's being applied
+		const SceneCommand command = commands[i];
+
+		//Nothing recorded after this point can be allowed to touch an object that's about to be deleted
+		if(command.type == SceneCommandType::DestroyObject){
+			DiscardCommandsFor({ command.target }, i + 1);
+		}else if(command.type == SceneCommandType::DestroyObjects){
+			DiscardCommandsFor(batches[command.batch], i + 1);
+		}else if(command.type == SceneCommandType::RemoveChild){
+			DiscardCommandsFor({ command.object }, i + 1);
+		}
 
-		if(go->Initialize() == false){
-			Debug::LogError("Could not create GameObject!", __FILE__, __LINE__);
-			GameManager::Stop();
+		if(ApplyCommand(command) == false){
+			//Don't leak whatever the remaining commands were going to add
+			for(size_t j = i + 1; j < commands.size(); j++){
+				ReleaseCommand(commands[j]);
+			}
+
+			commands.clear();
+			batches.clear();
 			return false;
 		}
-
-		gameObjectList.push_back(go);
 	}
 
-	//Destroy any objects that are set to be destroyed
-	while(!destroyQueue.empty()){
-		_ASSERT(destroyQueue.front() != nullptr);
-		GameObject* go = destroyQueue.front();
-		destroyQueue.pop();
-
-		go->Destroy();
-		delete go;
-		gameObjectList.erase(std::remove(gameObjectList.begin(), gameObjectList.end(), go), gameObjectList.end());
-	}
+	EngineStats::SetInt("Scene Commands", static_cast<long long>(recordedCommands));
+	EngineStats::SetInt("Pooled Objects", static_cast<long long>(ObjectPool::BlocksInUse()));
+	commands.clear();
+	batches.clear();
 
 	while(!skyQueue.empty()){
 		//Delete the current sky
@@ -187,21 +277,313 @@ bool Scene::MaintainQueues(){
 		}
 	}
 
-	while(!attachQueue.empty()){
-		_ASSERT(attachQueue.front() != nullptr);
-		GameObject* go = attachQueue.front();
-		attachQueue.pop();
+	return true;
+}
+
+bool Scene::ApplyCommand(const SceneCommand& command_){
+	GameObject* go = command_.target;
+
+	switch(command_.type){
+		case SceneCommandType::CreateObject:
+			go->SetScene(this);
+			if(go->Initialize() == false){
+				Debug::LogError("Could not create GameObject!", __FILE__, __LINE__);
+				GameManager::Stop();
+				return false;
+			}
+
+			AddRootObject(go);
+			break;
+		case SceneCommandType::CreateObjects:
+		{
+			//Take the batch out of the list, objects initializing here can spawn more batches
+			const std::vector<GameObject*> batch = std::move(batches[command_.batch]);
+			gameObjectList.reserve(gameObjectList.size() + batch.size());
+			ReserveRegistrations(batch);
+
+			Debug::StartProfiling("Scene Spawn Batch");
+			for(size_t i = 0; i < batch.size(); i++){
+				batch[i]->SetScene(this);
+				if(batch[i]->Initialize() == false){
+					Debug::LogError("Could not create GameObject!", __FILE__, __LINE__);
+					//Objects that made it into the scene will get cleaned up with it, the rest need to be cleaned up here
+					batch[i]->Destroy();
+					delete batch[i];
+					for(size_t j = i + 1; j < batch.size(); j++){
+						batch[j]->Destroy();
+						delete batch[j];
+					}
+
+					Debug::EndProfiling("Scene Spawn Batch");
+					GameManager::Stop();
+					return false;
+				}
+
+				AddRootObject(batch[i]);
+			}
+			Debug::EndProfiling("Scene Spawn Batch");
+			break;
+		}
+		case SceneCommandType::DestroyObject:
+			//One object can still take a whole hierarchy with it, like a grass field's blades
+			RenderEngine::BeginBatchUnregister();
+			PhysicsEngine::BeginBatchUnregister();
+			RemoveRootObject(go);
+			go->Destroy();
+			delete go;
+			PhysicsEngine::EndBatchUnregister();
+			RenderEngine::EndBatchUnregister();
+			break;
+		case SceneCommandType::DestroyObjects:
+		{
+			const std::vector<GameObject*> batch = std::move(batches[command_.batch]);
+
+			//Deleting an object deletes its children too, so anything under another object in the batch is already taken care of
+			std::unordered_set<GameObject*> descendants;
+			std::vector<GameObject*> toVisit;
+			for(GameObject* batchObject : batch){
+				toVisit.assign(batchObject->children.begin(), batchObject->children.end());
+				while(!toVisit.empty()){
+					GameObject* child = toVisit.back();
+					toVisit.pop_back();
+
+					//Children of something that's already been visited have been visited with it
+					if(descendants.insert(child).second){
+						toVisit.insert(toVisit.end(), child->children.begin(), child->children.end());
+					}
+				}
+			}
+
+			//Every object's components come out of the engines' lists together at the end, instead of each one searching them
+			Debug::StartProfiling("Scene Destroy Batch");
+			RenderEngine::BeginBatchUnregister();
+			PhysicsEngine::BeginBatchUnregister();
+
+			std::unordered_set<GameObject*> destroyed;
+			destroyed.reserve(batch.size());
+			for(GameObject* batchObject : batch){
+				//Objects listed more than once only get deleted the first time
+				if(descendants.find(batchObject) != descendants.end() || destroyed.insert(batchObject).second == false){
+					continue;
+				}
+
+				RemoveRootObject(batchObject);
+				batchObject->Destroy();
+				delete batchObject;
+			}
+
+			PhysicsEngine::EndBatchUnregister();
+			RenderEngine::EndBatchUnregister();
+			Debug::EndProfiling("Scene Destroy Batch");
+			break;
+		}
+		case SceneCommandType::AttachObject:
+			go->SetScene(this);
+			AddRootObject(go);
+			break;
+		case SceneCommandType::DetachObject:
+			RemoveRootObject(go);
+			break;
+		case SceneCommandType::AddComponent:
+			return go->ApplyAddComponent(command_.component);
+		case SceneCommandType::RemoveComponent:
+			go->ApplyRemoveComponent(command_.component);
+			break;
+		case SceneCommandType::AddChild:
+			return go->ApplyAddChild(command_.object);
+		case SceneCommandType::AddChildren:
+		{
+			const std::vector<GameObject*> batch = std::move(batches[command_.batch]);
+			ReserveRegistrations(batch);
+
+			Debug::StartProfiling("Scene Spawn Batch");
+			const bool added = go->ApplyAddChildren(batch);
+			Debug::EndProfiling("Scene Spawn Batch");
+			return added;
+		}
+		case SceneCommandType::RemoveChild:
+			go->ApplyRemoveChild(command_.object);
+			break;
+		case SceneCommandType::AttachChild:
+			go->ApplyAttachChild(command_.object);
+			break;
+		case SceneCommandType::DetachChild:
+			go->ApplyDetachChild(command_.object);
+			break;
+	}
+
+	return true;
+}
+
+void Scene::AddRootObject(GameObject* go_){
+	_ASSERT(go_ != nullptr);
+	if(go_->sceneIndex != notInScene){
+		return;
+	}
+
+	go_->sceneIndex = gameObjectList.size();
+	gameObjectList.push_back(go_);
+}
+
+void Scene::RemoveRootObject(GameObject* go_){
+	_ASSERT(go_ != nullptr);
+	if(go_->sceneIndex == notInScene){
+		return;
+	}
+
+	//Move the last object into this one's place so nothing else has to shift
+	const size_t index = go_->sceneIndex;
+	_ASSERT(index < gameObjectList.size() && gameObjectList[index] == go_);
+
+	GameObject* last = gameObjectList.back();
+	gameObjectList[index] = last;
+	last->sceneIndex = index;
+	gameObjectList.pop_back();
+
+	go_->sceneIndex = notInScene;
+}
+
+void Scene::RecordBatchCommand(SceneCommandType type_, std::vector<GameObject*>&& objects_, GameObject* target_){
+	_ASSERT(!objects_.empty());
+	commands.push_back(SceneCommand(type_, target_ != nullptr ? target_ : objects_.front(), nullptr, nullptr, batches.size()));
+	batches.push_back(std::move(objects_));
+}
+
+void Scene::ReserveRegistrations(const std::vector<GameObject*>& batch_){
+	size_t meshRenders = 0;
+	size_t rigidbodies = 0;
+	size_t colliders = 0;
+
+	//Prefabs can build children of their own, so count everything under each object as well
+	std::vector<GameObject*> toVisit = batch_;
+	while(!toVisit.empty()){
+		GameObject* go = toVisit.back();
+		toVisit.pop_back();
+
+		meshRenders += go->ComponentsOfType<MeshRender>().size();
+		rigidbodies += go->ComponentsOfType<Rigidbody>().size();
+		colliders += go->ComponentsOfType<Collider>().size();
+		toVisit.insert(toVisit.end(), go->children.begin(), go->children.end());
+	}
+
+	RenderEngine::ReserveMeshRenders(meshRenders);
+	PhysicsEngine::ReserveBodies(rigidbodies, colliders);
+}
+
+void Scene::DiscardCommandsFor(const std::vector<GameObject*>& objects_, size_t firstCommand_){
+	if(firstCommand_ >= commands.size()){
+		return;
+	}
+
+	//Gather the objects and everything under them, since deleting an object deletes its children too
+	std::unordered_set<GameObject*> deletedObjects;
+	std::vector<GameObject*> toVisit = objects_;
+	while(!toVisit.empty()){
+		GameObject* go = toVisit.back();
+		toVisit.pop_back();
+
+		deletedObjects.insert(go);
+		toVisit.insert(toVisit.end(), go->children.begin(), go->children.end());
+	}
+
+	const auto isDeleted = [&deletedObjects](GameObject* go_){
+		return deletedObjects.find(go_) != deletedObjects.end();
+	};
+
+	//Later bulk destroys just skip the objects that are already gone
+	for(size_t i = firstCommand_; i < commands.size(); i++){
+		if(commands[i].type == SceneCommandType::DestroyObjects){
+			std::vector<GameObject*>& batch = batches[commands[i].batch];
+			batch.erase(std::remove_if(batch.begin(), batch.end(), isDeleted), batch.end());
+		}
+	}
+
+	const auto isDiscarded = [&isDeleted](const SceneCommand& command_){
+		//Batches keep track of their own objects, target is only there to point at the first one
+		if(command_.type == SceneCommandType::CreateObjects || command_.type == SceneCommandType::DestroyObjects){
+			return false;
+		}else if(command_.type == SceneCommandType::AddChildren){
+			//The children aren't anywhere yet, so they only go if their parent does
+			return isDeleted(command_.target);
+		}
+
+		return isDeleted(command_.target) || isDeleted(command_.object);
+	};
+
+	for(size_t i = firstCommand_; i < commands.size(); i++){
+		if(isDiscarded(commands[i])){
+			ReleaseCommand(commands[i]);
+		}
+	}
+
+	commands.erase(std::remove_if(commands.begin() + firstCommand_, commands.end(), isDiscarded), commands.end());
+}
+
+std::vector<unsigned int> Scene::PrefabTags(const PrefabDescription& prefab_){
+	//Look each tag up once for the whole batch rather than once per object
+	std::vector<unsigned int> tags;
+	tags.reserve(prefab_.tags.size());
+	for(const std::string& tag : prefab_.tags){
+		tags.push_back(TagTable::GetTag(tag));
+	}
+
+	return tags;
+}
+
+void Scene::BuildObject(GameObject* go_, const PrefabDescription& prefab_, const std::vector<unsigned int>& tags_){
+	_ASSERT(go_ != nullptr);
 
-		gameObjectList.push_back(go);
+	go_->SetStatic(prefab_.isStatic);
+	for(unsigned int tag : tags_){
+		go_->SetTag(tag);
 	}
 
-	while(!detachQueue.empty()){
-		_ASSERT(detachQueue.front() != nullptr);
-		GameObject* go = detachQueue.front();
-		detachQueue.pop();
+	if(prefab_.build){
+		prefab_.build(go_);
+	}
+}
 
-		gameObjectList.erase(std::remove(gameObjectList.begin(), gameObjectList.end(), go), gameObjectList.end());
+void Scene::ReleaseCommand(const SceneCommand& command_){
+	switch(command_.type){
+		case SceneCommandType::CreateObject:
+			command_.target->Destroy();
+			delete command_.target;
+			break;
+		case SceneCommandType::CreateObjects:
+		case SceneCommandType::AddChildren:
+			for(GameObject* go : batches[command_.batch]){
+				go->Destroy();
+				delete go;
+			}
+			batches[command_.batch].clear();
+			break;
+		case SceneCommandType::AddChild:
+			command_.object->Destroy();
+			delete command_.object;
+			break;
+		case SceneCommandType::AddComponent:
+			command_.component->Destroy();
+			delete command_.component;
+			break;
+		default:
+			//Everything else refers to objects and components that are already owned by something
+			break;
 	}
+}
 
-	return true;
+void Scene::TrackComponentType(unsigned int typeID_){
+	_ASSERT(typeID_ < componentRegistries.size());
+	ComponentRegistry& registry = componentRegistries[typeID_];
+	registry.isTracked = true;
+	registry.components.Clear();
+
+	if(typeID_ >= ComponentTypeID::maxTypes){
+		return;
+	}
+
+	for(Component* c : allComponents.items){
+		if(ComponentTypeID::MaskOf(c).test(typeID_)){
+			registry.components.Add(c);
+		}
+	}
 }
\ No newline at end of file
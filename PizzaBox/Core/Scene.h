@@ -3,19 +3,41 @@
 
 #include <algorithm>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
+#include "Prefab.h"
 #include "Graphics/Sky/Sky.h"
 #include "Object/GameObject.h"
 
 namespace PizzaBox{
+	enum class SceneCommandType{
+		CreateObject,
+		CreateObjects,
+		DestroyObject,
+		DestroyObjects,
+		AttachObject,
+		DetachObject,
+		AddComponent,
+		RemoveComponent,
+		AddChild,
+		AddChildren,
+		RemoveChild,
+		AttachChild,
+		DetachChild
+	};
+
 	class Scene{
 	public:
+		static constexpr size_t notInScene = static_cast<size_t>(-1);
+
 		Scene();
 		virtual ~Scene();
 
 		virtual bool Initialize() = 0;
 		virtual void Destroy();
 
+		//Applies every structural change recorded since the last update, in the order they were recorded
 		bool Update();
 
 		template <class T, typename... ARGS> T* CreateObject(const Vector3& pos_ = Vector3(), const Euler& rot_ = Euler(), const Vector3& scale_ = Vector3(1.0f, 1.0f, 1.0f), const ARGS&... args_){
@@ -33,73 +55,204 @@ namespace PizzaBox{
 			if(parent_ != nullptr){
 				parent_->AddChild(t);
 			}else{
-				createQueue.push(t);
+				RecordCommand(SceneCommandType::CreateObject, t);
 			}
 
 			return t;
 		}
 
+		//Creates one object per position, all built from the same description, and adds them to the scene as a single batch
+		template <class T = GameObject> std::vector<T*> SpawnObjects(const PrefabDescription& prefab_, const std::vector<Vector3>& positions_, const std::vector<Euler>& rotations_ = std::vector<Euler>(), const std::vector<Vector3>& scales_ = std::vector<Vector3>(), GameObject* parent_ = nullptr){
+			static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
+			_ASSERT(rotations_.empty() || rotations_.size() == positions_.size());
+			_ASSERT(scales_.empty() || scales_.size() == positions_.size());
+
+			//Grab the memory for every object at once instead of a chunk at a time
+			ObjectPool::Reserve(sizeof(T), positions_.size());
+
+			const std::vector<unsigned int> tags = PrefabTags(prefab_);
+			std::vector<T*> objects = std::vector<T*>();
+			objects.reserve(positions_.size());
+
+			for(size_t i = 0; i < positions_.size(); i++){
+				T* t = new T(positions_[i], rotations_.empty() ? Euler() : rotations_[i], scales_.empty() ? Vector3(1.0f, 1.0f, 1.0f) : scales_[i]);
+				//The object isn't in a scene yet, so everything the description adds is applied straight away
+				BuildObject(t, prefab_, tags);
+				objects.push_back(t);
+			}
+
+			if(objects.empty()){
+				return objects;
+			}
+
+			std::vector<GameObject*> batch = std::vector<GameObject*>(objects.begin(), objects.end());
+			if(parent_ == nullptr){
+				RecordBatchCommand(SceneCommandType::CreateObjects, std::move(batch));
+			}else if(parent_->GetScene() != nullptr){
+				//Children go through the parent's scene, which might not be this one
+				parent_->GetScene()->RecordBatchCommand(SceneCommandType::AddChildren, std::move(batch), parent_);
+			}else{
+				//Parents that aren't in a scene take their children straight away, the same as AddChild
+				parent_->ApplyAddChildren(batch);
+			}
+
+			return objects;
+		}
+
 		void DestroyObject(GameObject* go_);
+		void DestroyObjects(const std::vector<GameObject*>& objects_);
 
 		void AttachObject(GameObject* go_);
 		void DetachObject(GameObject* go_);
 
+		//target_ is the object being changed, object_ and component_ are whatever is being added to or removed from it
+		void RecordCommand(SceneCommandType type_, GameObject* target_, GameObject* object_ = nullptr, Component* component_ = nullptr);
+
 		template <class T> T* GetComponentInScene(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			T* component = nullptr;
-
-			//Go through every object in the scene
-			for(GameObject* go : gameObjectList){
-				//If this object has a component of type T, grab it and return it
-				component = go->GetComponent<T>();
-				if(component != nullptr){
-					return component;
-				}
+			const std::vector<Component*>& compList = ComponentsInScene<T>();
 
-				//If any of this object's children have a component of type T, grab it and return it
-				component = go->GetComponentInChildren<T>();
-				if(component != nullptr){
-					return component;
-				}
+			//If no component is found, return nullptr
+			if(compList.empty()){
+				return nullptr;
 			}
 
-			//If no component is found, return nullptr
-			return nullptr;
+			return static_cast<T*>(compList.front());
 		}
 
 		template <class T> std::vector<T*> GetComponentsInScene(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			std::vector<T*> tmp = std::vector<T*>();
-			std::vector<T*> componentsInScene = std::vector<T*>();
+			const std::vector<Component*>& compList = ComponentsInScene<T>();
 
-			//Go through ever GameObject in the scene
-			for(GameObject* go : gameObjectList){
-				//Grab all components in this object's family and add it to our list
-				tmp = go->GetComponentsInFamily<T>();
-				for(T* t : tmp){
-					componentsInScene.push_back(t);
-				}
+			std::vector<T*> componentsInScene = std::vector<T*>();
+			componentsInScene.reserve(compList.size());
+			for(Component* c : compList){
+				componentsInScene.push_back(static_cast<T*>(c));
 			}
 
 			return componentsInScene;
 		}
 
+		//GameObjects call these as their components are added and removed
+		void RegisterComponent(Component* component_);
+		void UnregisterComponent(Component* component_);
+
 		GameObject* FindWithTag(const std::string& tag_);
+		GameObject* FindWithTag(unsigned int tag_);
 		std::vector<GameObject*> FindObjectsWithTag(const std::string& tag_);
+		//These return a copy, the scene's own lists are reordered and reallocated whenever objects are tagged or untagged
+		std::vector<GameObject*> FindAllWithTag(const std::string& tag_);
+		std::vector<GameObject*> FindAllWithTag(unsigned int tag_);
+
+		//GameObjects call these as their tags change
+		void RegisterTag(GameObject* go_, unsigned int tag_);
+		void UnregisterTag(GameObject* go_, unsigned int tag_);
 
 		Sky* GetSky();
 		void SetSky(Sky* sky_);
 
 	private:
+		//Unordered list that remembers where each item is, so items can be swapped out in constant time
+		template <class T> struct IndexedList{
+			IndexedList() : items(), indices(){}
+
+			std::vector<T*> items;
+			std::unordered_map<T*, size_t> indices;
+
+			bool Contains(T* item_) const{
+				return indices.find(item_) != indices.end();
+			}
+
+			void Add(T* item_){
+				if(Contains(item_)){
+					return;
+				}
+
+				indices[item_] = items.size();
+				items.push_back(item_);
+			}
+
+			void Remove(T* item_){
+				const auto index = indices.find(item_);
+				if(index == indices.end()){
+					return;
+				}
+
+				//Move the last item into the removed one's place so nothing else has to shift
+				const size_t i = index->second;
+				indices.erase(index);
+
+				if(i != items.size() - 1){
+					items[i] = items.back();
+					indices[items[i]] = i;
+				}
+
+				items.pop_back();
+			}
+
+			void Clear(){
+				items.clear();
+				indices.clear();
+			}
+		};
+
+		struct SceneCommand{
+			SceneCommand(SceneCommandType type_, GameObject* target_, GameObject* object_, Component* component_, size_t batch_ = 0) : type(type_), target(target_), object(object_), component(component_), batch(batch_){}
+
+			SceneCommandType type;
+			GameObject* target;
+			GameObject* object;
+			Component* component;
+			size_t batch; //Which entry in batches a CreateObjects, DestroyObjects or AddChildren command uses
+		};
+
+		//Every live component of one type
+		struct ComponentRegistry{
+			ComponentRegistry() : isTracked(false), components(){}
+
+			bool isTracked; //False until something asks for this type
+			IndexedList<Component> components;
+		};
+
 		std::vector<GameObject*> gameObjectList;
 		Sky *sky;
-		std::queue<GameObject*> createQueue;
-		std::queue<GameObject*> destroyQueue;
-		std::queue<GameObject*> attachQueue;
-		std::queue<GameObject*> detachQueue;
+		std::vector<SceneCommand> commands; //Cleared after every update, but keeps its memory for the next frame
+		std::vector<std::vector<GameObject*>> batches;
 		std::queue<Sky*> skyQueue;
 
-		bool MaintainQueues();
+		IndexedList<Component> allComponents;
+		std::vector<ComponentRegistry> componentRegistries; //Indexed by ComponentTypeID
+		std::vector<IndexedList<GameObject>> tagIndex; //Every object in the scene with each tag, indexed by tag ID
+
+		bool ApplyCommands();
+		void AddRootObject(GameObject* go_);
+		void RemoveRootObject(GameObject* go_);
+		bool ApplyCommand(const SceneCommand& command_);
+		//target_ defaults to the first object in the batch, AddChildren uses it for the parent instead
+		void RecordBatchCommand(SceneCommandType type_, std::vector<GameObject*>&& objects_, GameObject* target_ = nullptr);
+		//Lets every system a batch is about to register with grow its lists once for the whole batch
+		static void ReserveRegistrations(const std::vector<GameObject*>& batch_);
+		//Drops any later commands that refer to these objects (or their children) since they're about to be deleted
+		void DiscardCommandsFor(const std::vector<GameObject*>& objects_, size_t firstCommand_);
+		static std::vector<unsigned int> PrefabTags(const PrefabDescription& prefab_);
+		static void BuildObject(GameObject* go_, const PrefabDescription& prefab_, const std::vector<unsigned int>& tags_);
+		//Deletes whatever a command that won't be applied was going to add
+		void ReleaseCommand(const SceneCommand& command_);
+		void TrackComponentType(unsigned int typeID_);
+
+		template <class T> const std::vector<Component*>& ComponentsInScene(){
+			const unsigned int id = ComponentTypeID::Get<T>();
+			if(id >= componentRegistries.size()){
+				componentRegistries.resize(id + 1);
+			}
+
+			//Types are only tracked once they've been asked for, after which the registry is kept up to date as components come and go
+			if(!componentRegistries[id].isTracked){
+				TrackComponentType(id);
+			}
+
+			return componentRegistries[id].components.items;
+		}
 	};
 }
 
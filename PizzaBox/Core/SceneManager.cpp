@@ -5,12 +5,19 @@
 #include "Core/GameManager.h"
 #include "Graphics/UI/UIManager.h"
 #include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
 
 using namespace PizzaBox;
 
 std::vector<Scene*> SceneManager::sceneList = std::vector<Scene*>();
 int SceneManager::currentSceneIndex = -1;
 std::queue<unsigned int> SceneManager::sceneLoadQueue = std::queue<unsigned int>();
+std::vector<ResourceManifest> SceneManager::manifests = std::vector<ResourceManifest>();
+int SceneManager::nextSceneIndex = -1;
+std::vector<ResourceHandle<Resource>> SceneManager::preloadHandles = std::vector<ResourceHandle<Resource>>();
+std::vector<ResourceRequest<Resource>> SceneManager::preloadRequests = std::vector<ResourceRequest<Resource>>();
+bool SceneManager::isRecordingManifest = false;
+bool SceneManager::isTransitioning = false;
 
 //Suppress meaningless and unavoidable warning
 #pragma warning( push )
@@ -20,6 +27,7 @@ RTTR_REGISTRATION{
 		.method("Initialize", &SceneManager::Initialize)
 		.method("Destroy", &SceneManager::Destroy)
 		.method("Update", &SceneManager::Update)
+		.method("LateUpdate", &SceneManager::LateUpdate)
 		.method("AddScene", &SceneManager::AddScene)
 		.method("LoadInitialScene", &SceneManager::LoadInitialScene)
 		.method("LoadScene", &SceneManager::LoadScene)
@@ -28,7 +36,8 @@ RTTR_REGISTRATION{
 		.method("CurrentScene", &SceneManager::CurrentScene)
 		.method("CurrentSceneIndex", &SceneManager::CurrentSceneIndex)
 		.method("NumScenes", &SceneManager::NumScenes)
-		.method("TestLoadingAllScenes", &SceneManager::TestLoadingAllScenes);
+		.method("TestLoadingAllScenes", &SceneManager::TestLoadingAllScenes)
+		.method("IsChangingScene", &SceneManager::IsChangingScene);
 }
 #pragma warning( pop )
 
@@ -37,6 +46,10 @@ bool SceneManager::Initialize(){
 	currentSceneIndex = -1;
 	sceneList.clear();
 	sceneList.shrink_to_fit();
+	manifests.clear();
+	nextSceneIndex = -1;
+	isRecordingManifest = false;
+	isTransitioning = false;
 
 	while(!sceneLoadQueue.empty()){
 		sceneLoadQueue.pop();
@@ -46,6 +59,16 @@ bool SceneManager::Initialize(){
 }
 
 void SceneManager::Destroy(){
+	//Let go of anything that was preloaded for a scene change that never happened
+	ReleasePreload();
+	nextSceneIndex = -1;
+	isTransitioning = false;
+
+	if(isRecordingManifest){
+		ResourceManager::StopRecording();
+		isRecordingManifest = false;
+	}
+
 	for(Scene* scene : sceneList){
 		if(scene != nullptr){
 			scene->Destroy();
@@ -60,6 +83,7 @@ void SceneManager::Destroy(){
 
 	sceneList.clear();
 	sceneList.shrink_to_fit();
+	manifests.clear();
 	currentSceneIndex = -1;
 }
 
@@ -68,22 +92,41 @@ bool SceneManager::Update(){
 	_ASSERT(!sceneList.empty());
 	_ASSERT(CurrentScene() != nullptr);
 
-	if(!sceneLoadQueue.empty()){
-		if(ChangeToNewScene() == false){
-			Debug::LogError("Could not load new scene!", __FILE__, __LINE__);
-			return false;
-		}
+	//Only the first scene requested goes through, anything requested during the change waits until it's done
+	if(!sceneLoadQueue.empty() && nextSceneIndex < 0){
+		StartPreload(sceneLoadQueue.front());
 
 		while(!sceneLoadQueue.empty()){
 			sceneLoadQueue.pop();
 		}
 	}
 
+	//The current scene keeps running until everything the next one needs has been loaded
+	if(nextSceneIndex >= 0 && IsPreloadDone()){
+		if(ChangeToNewScene() == false){
+			Debug::LogError("Could not load new scene!", __FILE__, __LINE__);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SceneManager::LateUpdate(){
+	_ASSERT(currentSceneIndex != -1);
+	_ASSERT(CurrentScene() != nullptr);
+
+	//Everything that ran this frame has recorded its changes by now, including physics callbacks and scripts
 	if(CurrentScene()->Update() == false){
 		Debug::LogError("Could not update current scene!", __FILE__, __LINE__);
 		return false;
 	}
 
+	//The new scene's objects have taken their own loads now, so the preloaded ones can go
+	if(isRecordingManifest){
+		FinishManifest();
+	}
+
 	return true;
 }
 
@@ -92,6 +135,7 @@ void SceneManager::AddScene(Scene* newScene_){
 	_ASSERT(newScene_ != nullptr);
 
 	sceneList.push_back(newScene_);
+	manifests.push_back(ResourceManifest());
 }
 
 bool SceneManager::LoadInitialScene(){
@@ -101,6 +145,7 @@ bool SceneManager::LoadInitialScene(){
 	_ASSERT(sceneList.size() > 0);
 
 	currentSceneIndex = 0;
+	StartManifest();
 	if(sceneList[currentSceneIndex]->Initialize() == false){
 		Debug::LogError("Scene could not be initialized!", __FILE__, __LINE__);
 		return false;
@@ -163,21 +208,86 @@ bool SceneManager::TestLoadingAllScenes(){
 	//You should only use this BEFORE actually loading any scenes
 	_ASSERT(currentSceneIndex == -1);
 
+	//Scenes are loaded back to back the same way a scene change would, so the reload counts show how much work each change would redo
 	for(unsigned int i = 0; i < sceneList.size(); i++){
+		Debug::StartProfiling("Scene Load Test");
+		ResourceManager::StartRecording();
+
 		if(sceneList[i]->Initialize() == false){
+			ResourceManager::StopRecording();
+			Debug::EndProfiling("Scene Load Test");
 			Debug::LogError("Scene at index " + std::to_string(i) + " failed to initialize!", __FILE__, __LINE__);
 			return false;
 		}
 
-		Debug::Log("Scene " + std::to_string(i) + " initialized successfully", __FILE__, __LINE__);
+		//Objects only load their resources once the scene's first update adds them
+		const bool updated = sceneList[i]->Update();
+		manifests[i] = ResourceManager::StopRecording();
+		const double seconds = Debug::EndProfiling("Scene Load Test");
+
+		if(updated == false){
+			Debug::LogError("Scene at index " + std::to_string(i) + " failed its first update!", __FILE__, __LINE__);
+			sceneList[i]->Destroy();
+			return false;
+		}
+
+		Debug::Log("Scene " + std::to_string(i) + " initialized successfully in " + std::to_string(seconds) + "s, " +
+			std::to_string(manifests[i].loadsFromDisk) + " of its " + std::to_string(manifests[i].resources.size()) + " resources were loaded from disk", __FILE__, __LINE__
+		);
 		sceneList[i]->Destroy();
 	}
 
 	return true;
 }
 
+void SceneManager::StartPreload(unsigned int sceneIndex_){
+	_ASSERT(sceneIndex_ < sceneList.size());
+	_ASSERT(preloadRequests.empty());
+
+	nextSceneIndex = static_cast<int>(sceneIndex_);
+	Debug::StartProfiling("Scene Preload");
+
+	//Scenes that haven't been loaded before have no manifest yet, so they change over straight away like they used to
+	preloadHandles = manifests[sceneIndex_].resources;
+	preloadRequests.reserve(preloadHandles.size());
+
+	//These are the next scene's resources, so they mustn't end up in the manifest the current scene might still be recording
+	ResourceManager::PauseRecording();
+	for(const auto& handle : preloadHandles){
+		preloadRequests.push_back(ResourceManager::LoadResourceAsync(handle));
+	}
+	ResourceManager::ResumeRecording();
+}
+
+bool SceneManager::IsPreloadDone(){
+	for(const auto& request : preloadRequests){
+		if(!request.IsDone()){
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SceneManager::ReleasePreload(){
+	_ASSERT(preloadHandles.size() == preloadRequests.size());
+
+	//Failed requests never got a load, so there's nothing to give back for them
+	for(size_t i = 0; i < preloadRequests.size(); i++){
+		if(preloadRequests[i].IsReady()){
+			ResourceManager::UnloadResource(preloadHandles[i]);
+		}
+	}
+
+	preloadHandles.clear();
+	preloadRequests.clear();
+}
+
 bool SceneManager::ChangeToNewScene(){
-	unsigned int newIndex = sceneLoadQueue.front();
+	_ASSERT(nextSceneIndex >= 0);
+	const unsigned int newIndex = static_cast<unsigned int>(nextSceneIndex);
+	nextSceneIndex = -1;
+	Debug::EndProfiling("Scene Preload");
 
 	//Make sure that a scene is loaded
 	//If you're hitting this assertion, you should be using LoadInitialScene
@@ -187,7 +297,11 @@ bool SceneManager::ChangeToNewScene(){
 	//Redundant, but check that there's at least one scene in the scene list
 	_ASSERT(sceneList.size() > 0);
 
-	//Unload the current scene
+	//The stall is everything from here to the end of the new scene's first update
+	Debug::StartProfiling("Scene Transition");
+	isTransitioning = true;
+
+	//Unload the current scene, anything the next scene shares with it is still held by the preload
 	sceneList[currentSceneIndex]->Destroy();
 
 	UIManager::DisableAllSets(); //Disable all UI elements when we change scenes
@@ -195,6 +309,7 @@ bool SceneManager::ChangeToNewScene(){
 
 	//Set the current scene index and load the current scene
 	currentSceneIndex = newIndex;
+	StartManifest();
 	if(sceneList[currentSceneIndex]->Initialize() == false){
 		Debug::LogError("Scene could not be initialized!", __FILE__, __LINE__);
 		GameManager::Stop();
@@ -202,4 +317,29 @@ bool SceneManager::ChangeToNewScene(){
 	}
 
 	return true;
+}
+
+void SceneManager::StartManifest(){
+	//A recording left over from a scene that failed to initialize is thrown away
+	if(isRecordingManifest){
+		ResourceManager::StopRecording();
+	}
+
+	ResourceManager::StartRecording();
+	isRecordingManifest = true;
+}
+
+void SceneManager::FinishManifest(){
+	_ASSERT(isRecordingManifest);
+
+	manifests[currentSceneIndex] = ResourceManager::StopRecording();
+	isRecordingManifest = false;
+
+	//Only scene changes have a preload and a stall to measure, the initial scene has neither
+	if(isTransitioning){
+		isTransitioning = false;
+		ReleasePreload();
+		EngineStats::SetFloat("Scene Transition Stall", static_cast<float>(Debug::EndProfiling("Scene Transition")));
+		EngineStats::SetInt("Scene Transition Reloads", static_cast<long long>(manifests[currentSceneIndex].loadsFromDisk));
+	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Scene.h"
+#include "Resource/ResourceManager.h"
 
 namespace PizzaBox{
 	class SceneManager{
@@ -11,7 +12,10 @@ namespace PizzaBox{
 		static bool Initialize();
 		static void Destroy();
 
+		//Starts scene changes, this should happen before anything else in the frame
 		static bool Update();
+		//Applies the changes recorded to the current scene during the frame, this should happen after all game logic and before physics starts its threaded step
+		static bool LateUpdate();
 
 		static void AddScene(Scene* newScene_);
 		static bool LoadInitialScene();
@@ -22,7 +26,9 @@ namespace PizzaBox{
 		static int CurrentSceneIndex();
 		static unsigned int NumScenes();
 
+		//Initializes and updates every scene once, which also records the manifests used to preload them later
 		static bool TestLoadingAllScenes();
+		inline static bool IsChangingScene(){ return nextSceneIndex >= 0; }
 
 		//Delete unwanted compiler-generated constructors, destructors and assignment operators
 		SceneManager() = delete;
@@ -37,7 +43,21 @@ namespace PizzaBox{
 		static int currentSceneIndex;
 		static std::queue<unsigned int> sceneLoadQueue;
 
+		//Scene changes are overlapped with the current scene, the next scene's manifest is loaded asynchronously while the current scene keeps running
+		//The preloaded resources are held until the new scene has taken its own loads, so resources shared by both scenes are never unloaded in between
+		static std::vector<ResourceManifest> manifests; //Indexed the same as sceneList, empty until a scene has been loaded once
+		static int nextSceneIndex;
+		static std::vector<ResourceHandle<Resource>> preloadHandles;
+		static std::vector<ResourceRequest<Resource>> preloadRequests;
+		static bool isRecordingManifest; //Set from a scene's Initialize until the end of its first update, when its objects load their resources
+		static bool isTransitioning; //Set from when the old scene is destroyed until the end of the new scene's first update
+
+		static void StartPreload(unsigned int sceneIndex_);
+		static bool IsPreloadDone();
+		static void ReleasePreload();
 		static bool ChangeToNewScene();
+		static void StartManifest();
+		static void FinishManifest();
 	};
 }
 
@@ -0,0 +1,148 @@
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+namespace PizzaBox{
+	class LineRange;
+
+	//A view of characters owned by something else, usually a MappedFile
+	//The names match std::string_view so this can be swapped for it once the engine moves to C++17
+	class StringView{
+	public:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		constexpr StringView() : ptr(nullptr), length(0){}
+		constexpr StringView(const char* data_, size_t size_) : ptr(data_), length(size_){}
+		StringView(const char* string_) : ptr(string_), length(strlen(string_)){}
+		StringView(const std::string& string_) : ptr(string_.data()), length(string_.size()){}
+
+		inline const char* data() const{ return ptr; }
+		inline size_t size() const{ return length; }
+		inline bool empty() const{ return length == 0; }
+		inline const char* begin() const{ return ptr; }
+		inline const char* end() const{ return ptr + length; }
+		inline char operator[](size_t index_) const{ return ptr[index_]; }
+		inline char front() const{ return ptr[0]; }
+		inline char back() const{ return ptr[length - 1]; }
+
+		StringView substr(size_t pos_, size_t count_ = npos) const{
+			pos_ = std::min(pos_, length);
+			return StringView(ptr + pos_, std::min(count_, length - pos_));
+		}
+
+		size_t find(char c_, size_t pos_ = 0) const{
+			if(pos_ >= length){
+				return npos;
+			}
+
+			const void* found = memchr(ptr + pos_, c_, length - pos_);
+			return (found == nullptr) ? npos : static_cast<size_t>(static_cast<const char*>(found) - ptr);
+		}
+
+		size_t find(StringView view_, size_t pos_ = 0) const{
+			if(pos_ > length){
+				return npos;
+			}
+
+			const char* found = std::search(ptr + pos_, end(), view_.begin(), view_.end());
+			return (found == end() && !view_.empty()) ? npos : static_cast<size_t>(found - ptr);
+		}
+
+		size_t rfind(char c_) const{
+			for(size_t i = length; i > 0; i--){
+				if(ptr[i - 1] == c_){
+					return i - 1;
+				}
+			}
+
+			return npos;
+		}
+
+		inline std::string ToString() const{ return std::string(ptr, length); }
+
+		//Splits on '\n', dropping the '\r' of Windows line endings
+		LineRange Lines() const;
+
+		inline bool operator==(StringView other_) const{ return length == other_.length && std::equal(begin(), end(), other_.begin()); }
+		inline bool operator!=(StringView other_) const{ return !(*this == other_); }
+
+	private:
+		const char* ptr;
+		size_t length;
+	};
+
+	//Walks through a view one line at a time without copying anything
+	class LineIterator{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = StringView;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const StringView*;
+		using reference = const StringView&;
+
+		LineIterator(StringView remaining_, bool atEnd_) : remaining(remaining_), line(), atEnd(atEnd_){
+			if(!atEnd){
+				Advance();
+			}
+		}
+
+		inline reference operator*() const{ return line; }
+		inline pointer operator->() const{ return &line; }
+
+		LineIterator& operator++(){
+			Advance();
+			return *this;
+		}
+
+		LineIterator operator++(int){
+			LineIterator previous = *this;
+			Advance();
+			return previous;
+		}
+
+		inline bool operator==(const LineIterator& other_) const{ return atEnd == other_.atEnd && (atEnd || remaining.data() == other_.remaining.data()); }
+		inline bool operator!=(const LineIterator& other_) const{ return !(*this == other_); }
+
+	private:
+		StringView remaining;
+		StringView line;
+		bool atEnd;
+
+		//Like std::getline, a newline at the very end doesn't start another line
+		void Advance(){
+			if(remaining.empty()){
+				atEnd = true;
+				return;
+			}
+
+			const size_t newline = remaining.find('\n');
+			line = remaining.substr(0, newline);
+			remaining = (newline == StringView::npos) ? StringView(remaining.end(), 0) : remaining.substr(newline + 1);
+
+			if(!line.empty() && line.back() == '\r'){
+				line = line.substr(0, line.size() - 1);
+			}
+		}
+	};
+
+	class LineRange{
+	public:
+		explicit LineRange(StringView view_) : view(view_){}
+
+		inline LineIterator begin() const{ return LineIterator(view, false); }
+		inline LineIterator end() const{ return LineIterator(view, true); }
+
+	private:
+		StringView view;
+	};
+
+	inline LineRange StringView::Lines() const{
+		return LineRange(*this);
+	}
+}
+
+#endif //!STRING_VIEW_H
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "GrassSimulation.h"
 
+#include "Core/SceneManager.h"
 #include "Graphics/Materials/GrassMaterial.h"
 #include "Graphics/Models/MeshRender.h"
 
@@ -25,21 +26,33 @@ bool GrassSimulation::Initialize(GameObject* go_){
 }
 
 void GrassSimulation::GenerateField(){
+	//Every blade is two crossed quads, so lay out both halves of the field and spawn them as one batch
+	std::vector<Vector3> positions;
+	std::vector<Euler> rotations;
+	std::vector<Vector3> scales;
+	positions.reserve(grassAmount * 2);
+	rotations.reserve(grassAmount * 2);
+	scales.reserve(grassAmount * 2);
+
 	for(int i = 0; i < grassAmount; i++){
-		GameObject* grass = new GameObject();
-		GameObject* grass2 = new GameObject();
-		grassField->AddChild(grass);
-		grassField->AddChild(grass2);
-
-		grass->GetTransform()->SetPosition(gameObject->GetPosition().x * i + 1, gameObject->GetPosition().y, gameObject->GetPosition().z);
-		grass->SetScale(gameObject->GetScale());
-		grass->AddComponent(new PizzaBox::MeshRender("GrassMesh", new PizzaBox::GrassMaterial(diffuseMapName, specularMapName, normalMapName, shininess, sway, frequency)));
-
-		grass2->GetTransform()->SetPosition(gameObject->GetPosition().x * i + 1, gameObject->GetPosition().y, gameObject->GetPosition().z);
-		grass2->SetScale(gameObject->GetScale());
-		grass2->GetTransform()->SetRotation(0.0f, 90.0f, 0.0f);
-		grass2->AddComponent(new PizzaBox::MeshRender("GrassMesh", new PizzaBox::GrassMaterial(diffuseMapName, specularMapName, normalMapName, shininess, sway, frequency)));
+		const Vector3 position = Vector3(gameObject->GetPosition().x * i + 1, gameObject->GetPosition().y, gameObject->GetPosition().z);
+
+		positions.push_back(position);
+		rotations.push_back(Euler());
+		scales.push_back(gameObject->GetScale());
+
+		positions.push_back(position);
+		rotations.push_back(Euler(0.0f, 90.0f, 0.0f));
+		scales.push_back(gameObject->GetScale());
 	}
+
+	PrefabDescription grass = PrefabDescription([this](GameObject* go_){
+		go_->AddComponent(new PizzaBox::MeshRender("GrassMesh", new PizzaBox::GrassMaterial(diffuseMapName, specularMapName, normalMapName, shininess, sway, frequency)));
+	});
+
+	//Spawn into whichever scene owns this component, which isn't necessarily the current one during a scene change
+	Scene* scene = gameObject->GetScene() != nullptr ? gameObject->GetScene() : SceneManager::CurrentScene();
+	scene->SpawnObjects(grass, positions, rotations, scales, grassField);
 }
 
 void GrassSimulation::Destroy(){
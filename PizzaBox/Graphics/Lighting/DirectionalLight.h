@@ -11,6 +11,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		inline Component* Clone() const override{ return new DirectionalLight(*this); }
 	};
 }
 
@@ -11,6 +11,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		inline Component* Clone() const override{ return new PointLight(*this); }
 
 		inline float GetConstant() const{ return constant; }
 		inline float GetLinear() const{ return linear; }
@@ -11,6 +11,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		inline Component* Clone() const override{ return new SpotLight(*this); }
 
 		inline float GetCutOff() const{ return cutOff; }
 		inline float GetOuterCutOff() const{ return outerCutOff; }
@@ -20,12 +20,12 @@ void VAO::Unbind() const{
 	glBindVertexArray(0);
 }
 
-void VAO::SetupVertexAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_){
-	glVertexAttribPointer(id_, num_, GL_FLOAT, GL_FALSE, stride_, offset_);
+void VAO::SetupVertexAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_, GLenum type_, GLboolean normalized_){
+	glVertexAttribPointer(id_, num_, type_, normalized_, stride_, offset_);
 	glEnableVertexAttribArray(id_);
 }
 
-void VAO::SetupVertexIntAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_){
-	glVertexAttribIPointer(id_, num_, GL_INT, stride_, offset_);
+void VAO::SetupVertexIntAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_, GLenum type_){
+	glVertexAttribIPointer(id_, num_, type_, stride_, offset_);
 	glEnableVertexAttribArray(id_);
 }
\ No newline at end of file
@@ -14,8 +14,8 @@ namespace PizzaBox{
 		void Bind() const;
 		void Unbind() const;
 
-		void SetupVertexAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_);
-		void SetupVertexIntAttribute(unsigned int id_, unsigned int num_, unsigned int stride_, const GLvoid* offset_);
+		void SetupVertexAttribute(unsigned int id_, unsigned int num_, const unsigned int stride_, const GLvoid* offset_, GLenum type_ = GL_FLOAT, GLboolean normalized_ = GL_FALSE);
+		void SetupVertexIntAttribute(unsigned int id_, unsigned int num_, unsigned int stride_, const GLvoid* offset_, GLenum type_ = GL_INT);
 	};
 }
 
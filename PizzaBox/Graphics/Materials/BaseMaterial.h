@@ -4,12 +4,13 @@
 #include <string>
 
 #include "Graphics/Shader.h"
+#include "Resource/ResourceManager.h"
 #include "Tools/Debug.h"
 
 namespace PizzaBox{
 	class BaseMaterial{
 	public:
-		BaseMaterial(std::string shaderName_) : shaderName(shaderName_), shader(nullptr){}
+		BaseMaterial(std::string shaderName_) : shaderName(shaderName_), shaderHandle(), shader(nullptr){}
 		virtual ~BaseMaterial(){
 			#ifdef _DEBUG
 			if(shader != nullptr){
@@ -26,8 +27,43 @@ namespace PizzaBox{
 
 	protected:
 		std::string shaderName;
+		ResourceHandle<Shader> shaderHandle; //Looked up the first time the shader is loaded, since derived materials can still change shaderName in their constructors
 		Shader* shader;
 
+		bool LoadShader(){
+			if(!shaderHandle.IsValid()){
+				shaderHandle = ResourceManager::GetHandle<Shader>(shaderName);
+			}
+
+			return LoadHandle(shaderHandle, shader);
+		}
+
+		void UnloadShader(){
+			UnloadHandle(shaderHandle, shader);
+		}
+
+		//Loads a resource through its handle unless it's already there, clones come in with their resources already referenced
+		template <class T> static bool LoadHandle(const ResourceHandle<T>& handle_, T*& resource_){
+			if(resource_ != nullptr){
+				return true;
+			}
+
+			resource_ = ResourceManager::LoadResource(handle_);
+			if(resource_ == nullptr){
+				Debug::LogError(ResourceManager::GetName(handle_) + " could not be loaded!", __FILE__, __LINE__);
+				return false;
+			}
+
+			return true;
+		}
+
+		template <class T> static void UnloadHandle(const ResourceHandle<T>& handle_, T*& resource_){
+			if(resource_ != nullptr){
+				ResourceManager::UnloadResource(handle_);
+				resource_ = nullptr;
+			}
+		}
+
 		virtual void SetupUniforms(){}
 		virtual void CleanupUniforms(){}
 	};
@@ -19,9 +19,7 @@ ColorMaterial::~ColorMaterial(){
 }
 
 bool ColorMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 	
@@ -29,10 +27,13 @@ bool ColorMaterial::Initialize(){
 }
 
 void ColorMaterial::Destroy(){
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+	UnloadShader();
+}
+
+MeshMaterial* ColorMaterial::Clone() const{
+	ColorMaterial* clone = new ColorMaterial(*this);
+	clone->shader = ResourceManager::AddReference(shader);
+	return clone;
 }
 
 void ColorMaterial::Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector <SpotLight*>& spotLights_) const{
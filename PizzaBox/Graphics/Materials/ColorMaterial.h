@@ -12,6 +12,7 @@ namespace PizzaBox{
 
 		virtual bool Initialize() override;
 		virtual void Destroy() override;
+		virtual MeshMaterial* Clone() const override;
 
 		virtual void Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_) const override;
 
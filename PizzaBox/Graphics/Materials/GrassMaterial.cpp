@@ -7,47 +7,23 @@
 
 using namespace PizzaBox;
 
-GrassMaterial::GrassMaterial(const std::string& diffMap_, const std::string& specMap_, const std::string& normalMap_, float shiny_, const Vector3& sway_, float frequency_) : MeshMaterial("GrassShader"), diffuseMapName(diffMap_), diffuseMap(nullptr), specularMap(nullptr), normalMapName(normalMap_), normalMap(nullptr), shininess(shiny_), sway(sway_), frequency(frequency_), time(0.0f), textureScale(1.0f){
-	_ASSERT(!diffuseMapName.empty());
+GrassMaterial::GrassMaterial(const std::string& diffMap_, const std::string& specMap_, const std::string& normalMap_, float shiny_, const Vector3& sway_, float frequency_) : MeshMaterial("GrassShader"), diffuseMapHandle(ResourceManager::GetHandle<Texture>(diffMap_)), diffuseMap(nullptr), specularMap(nullptr), normalMapHandle(), normalMap(nullptr), shininess(shiny_), sway(sway_), frequency(frequency_), time(0.0f), textureScale(1.0f){
+	_ASSERT(!diffMap_.empty());
 
-	if(specMap_.empty()){
-		specularMapName = diffuseMapName;
-	}else{
-		specularMapName = specMap_;
-	}
-
-	if(normalMap_.empty()){
-		normalMapName = diffuseMapName;
-	}else{
-		normalMapName = normalMap_;
-	}
+	//The names are only looked up here, loading and unloading goes through the handles after this
+	specularMapHandle = specMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(specMap_);
+	normalMapHandle = normalMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(normalMap_);
 }
 
 GrassMaterial::~GrassMaterial(){
 }
 
 bool GrassMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	diffuseMap = ResourceManager::LoadResource<Texture>(diffuseMapName);
-	if(diffuseMap == nullptr){
-		Debug::LogError(diffuseMapName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	specularMap = ResourceManager::LoadResource<Texture>(specularMapName);
-	if(specularMap == nullptr){
-		Debug::LogError(specularMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 
-	normalMap = ResourceManager::LoadResource<Texture>(normalMapName);
-	if(normalMap == nullptr){
-		Debug::LogError(normalMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadHandle(diffuseMapHandle, diffuseMap) == false || LoadHandle(specularMapHandle, specularMap) == false || LoadHandle(normalMapHandle, normalMap) == false){
 		return false;
 	}
 
@@ -55,25 +31,19 @@ bool GrassMaterial::Initialize(){
 }
 
 void GrassMaterial::Destroy(){
-	if(diffuseMap != nullptr){
-		ResourceManager::UnloadResource(diffuseMapName);
-		diffuseMap = nullptr;
-	}
-
-	if(specularMap != nullptr){
-		ResourceManager::UnloadResource(specularMapName);
-		specularMap = nullptr;
-	}
-
-	if(normalMap != nullptr){
-		ResourceManager::UnloadResource(normalMapName);
-		normalMap = nullptr;
-	}
+	UnloadHandle(diffuseMapHandle, diffuseMap);
+	UnloadHandle(specularMapHandle, specularMap);
+	UnloadHandle(normalMapHandle, normalMap);
+	UnloadShader();
+}
 
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+MeshMaterial* GrassMaterial::Clone() const{
+	GrassMaterial* clone = new GrassMaterial(*this);
+	clone->shader = ResourceManager::AddReference(shader);
+	clone->diffuseMap = ResourceManager::AddReference(diffuseMap);
+	clone->specularMap = ResourceManager::AddReference(specularMap);
+	clone->normalMap = ResourceManager::AddReference(normalMap);
+	return clone;
 }
 
 void GrassMaterial::Update(){
@@ -16,6 +16,9 @@ namespace PizzaBox{
 		virtual bool Initialize() override = 0;
 		virtual void Destroy() override = 0;
 
+		//Makes an uninitialized copy that shares whatever resources this material has loaded, materials that can't be copied return nullptr
+		virtual MeshMaterial* Clone() const{ return nullptr; }
+
 		virtual void Update(){}
 		virtual void Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_) const = 0;
 
@@ -18,8 +18,8 @@ Vector3 PerlinMaterial::g3[514];
 
 GLubyte* PerlinMaterial::Noise3DTexPtr;
 
-PerlinMaterial::PerlinMaterial(const std::string& diffMap_, const std::string& specMap_, const std::string& normalMap_, float shiny_, float speedMult_, float offsetMult_, bool textureIsMoving_) : MeshMaterial("PerlinShader"), diffuseMapName(diffMap_), specularMapName(specMap_), specularMap(nullptr), diffuseMap(nullptr), normalMapName(normalMap_), normalMap(nullptr), shininess(shiny_), speedMult(speedMult_), offsetMult(offsetMult_), textureIsMoving(textureIsMoving_), time(0.0f), textureScale(1.0f), noiseTexture(0){
-	_ASSERT(!diffuseMapName.empty());
+PerlinMaterial::PerlinMaterial(const std::string& diffMap_, const std::string& specMap_, const std::string& normalMap_, float shiny_, float speedMult_, float offsetMult_, bool textureIsMoving_) : MeshMaterial("PerlinShader"), diffuseMapHandle(ResourceManager::GetHandle<Texture>(diffMap_)), specularMapHandle(), specularMap(nullptr), diffuseMap(nullptr), normalMapHandle(), normalMap(nullptr), shininess(shiny_), speedMult(speedMult_), offsetMult(offsetMult_), textureIsMoving(textureIsMoving_), time(0.0f), textureScale(1.0f), noiseTexture(0){
+	_ASSERT(!diffMap_.empty());
 
 #ifdef _DEBUG
 	if(offsetMult == 0.0f){
@@ -34,40 +34,20 @@ PerlinMaterial::PerlinMaterial(const std::string& diffMap_, const std::string& s
 #endif //_DEBUG
 
 
-	if(specMap_.empty()){
-		specularMapName = diffuseMapName;
-	}
-
-	if(normalMap_.empty()){
-		normalMapName = diffuseMapName;
-	}
+	//The names are only looked up here, loading and unloading goes through the handles after this
+	specularMapHandle = specMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(specMap_);
+	normalMapHandle = normalMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(normalMap_);
 }
 
 PerlinMaterial::~PerlinMaterial(){
 }
 
 bool PerlinMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	diffuseMap = ResourceManager::LoadResource<Texture>(diffuseMapName);
-	if(diffuseMap == nullptr){
-		Debug::LogError(diffuseMapName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	specularMap = ResourceManager::LoadResource<Texture>(specularMapName);
-	if(specularMap == nullptr){
-		Debug::LogError(specularMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 
-	normalMap = ResourceManager::LoadResource<Texture>(normalMapName);
-	if(normalMap == nullptr){
-		Debug::LogError(normalMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadHandle(diffuseMapHandle, diffuseMap) == false || LoadHandle(specularMapHandle, specularMap) == false || LoadHandle(normalMapHandle, normalMap) == false){
 		return false;
 	}
 
@@ -79,25 +59,20 @@ bool PerlinMaterial::Initialize(){
 void PerlinMaterial::Destroy(){
 	//TODO - Cleanup noise texture
 
-	if(diffuseMap != nullptr){
-		ResourceManager::UnloadResource(diffuseMapName);
-		diffuseMap = nullptr;
-	}
-
-	if(specularMap != nullptr){
-		ResourceManager::UnloadResource(specularMapName);
-		specularMap = nullptr;
-	}
-
-	if(normalMap != nullptr){
-		ResourceManager::UnloadResource(normalMapName);
-		normalMap = nullptr;
-	}
+	UnloadHandle(diffuseMapHandle, diffuseMap);
+	UnloadHandle(specularMapHandle, specularMap);
+	UnloadHandle(normalMapHandle, normalMap);
+	UnloadShader();
+}
 
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+MeshMaterial* PerlinMaterial::Clone() const{
+	PerlinMaterial* clone = new PerlinMaterial(*this);
+	clone->noiseTexture = 0; //Every material makes its own noise texture when it's initialized
+	clone->shader = ResourceManager::AddReference(shader);
+	clone->diffuseMap = ResourceManager::AddReference(diffuseMap);
+	clone->specularMap = ResourceManager::AddReference(specularMap);
+	clone->normalMap = ResourceManager::AddReference(normalMap);
+	return clone;
 }
 
 void PerlinMaterial::Update(){
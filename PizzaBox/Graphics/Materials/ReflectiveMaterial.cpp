@@ -14,9 +14,7 @@ ReflectiveMaterial::~ReflectiveMaterial(){
 }
 
 bool ReflectiveMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 
@@ -28,10 +26,13 @@ bool ReflectiveMaterial::Initialize(){
 void ReflectiveMaterial::Destroy(){
 	CleanupUniforms();
 
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+	UnloadShader();
+}
+
+MeshMaterial* ReflectiveMaterial::Clone() const{
+	ReflectiveMaterial* clone = new ReflectiveMaterial(*this);
+	clone->shader = ResourceManager::AddReference(shader);
+	return clone;
 }
 
 void ReflectiveMaterial::Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights) const{
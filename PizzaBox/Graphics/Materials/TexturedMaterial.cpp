@@ -5,24 +5,16 @@
 
 using namespace PizzaBox;
 
-TexturedMaterial::TexturedMaterial(const std::string& diffMap_, bool animated_, const std::string& specMap_, const std::string& normalMap_, float shiny_, float resizeTexture_) : MeshMaterial("DefaultShader"), diffuseMapName(diffMap_), diffuseMap(nullptr), specularMap(nullptr), normalMapName(normalMap_), normalMap(nullptr), shininess(shiny_), textureScale(resizeTexture_){
-	_ASSERT(!diffuseMapName.empty());
+TexturedMaterial::TexturedMaterial(const std::string& diffMap_, bool animated_, const std::string& specMap_, const std::string& normalMap_, float shiny_, float resizeTexture_) : MeshMaterial("DefaultShader"), diffuseMapHandle(ResourceManager::GetHandle<Texture>(diffMap_)), diffuseMap(nullptr), specularMap(nullptr), normalMapHandle(), normalMap(nullptr), shininess(shiny_), textureScale(resizeTexture_){
+	_ASSERT(!diffMap_.empty());
 
 	if(animated_){
 		shaderName = "AnimTextureShader";
 	}
 
-	if(specMap_.empty()){
-		specularMapName = diffuseMapName;
-	}else{
-		specularMapName = specMap_;
-	}
-
-	if(normalMap_.empty()){
-		normalMapName = diffuseMapName;
-	}else{
-		normalMapName = normalMap_;
-	}
+	//The names are only looked up here, loading and unloading goes through the handles after this
+	specularMapHandle = specMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(specMap_);
+	normalMapHandle = normalMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(normalMap_);
 }
 
 TexturedMaterial::~TexturedMaterial(){
@@ -35,27 +27,11 @@ TexturedMaterial::~TexturedMaterial(){
 }
 
 bool TexturedMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	diffuseMap = ResourceManager::LoadResource<Texture>(diffuseMapName);
-	if(diffuseMap == nullptr){
-		Debug::LogError(diffuseMapName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	specularMap = ResourceManager::LoadResource<Texture>(specularMapName);
-	if(specularMap == nullptr){
-		Debug::LogError(specularMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 
-	normalMap = ResourceManager::LoadResource<Texture>(normalMapName);
-	if(normalMap == nullptr){
-		Debug::LogError(normalMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadHandle(diffuseMapHandle, diffuseMap) == false || LoadHandle(specularMapHandle, specularMap) == false || LoadHandle(normalMapHandle, normalMap) == false){
 		return false;
 	}
 
@@ -67,25 +43,19 @@ bool TexturedMaterial::Initialize(){
 void TexturedMaterial::Destroy(){
 	CleanupUniforms();
 
-	if(diffuseMap != nullptr){
-		ResourceManager::UnloadResource(diffuseMapName);
-		diffuseMap = nullptr;
-	}
-
-	if(specularMap != nullptr){
-		ResourceManager::UnloadResource(specularMapName);
-		specularMap = nullptr;
-	}
-
-	if(normalMap != nullptr){
-		ResourceManager::UnloadResource(normalMapName);
-		normalMap = nullptr;
-	}
+	UnloadHandle(diffuseMapHandle, diffuseMap);
+	UnloadHandle(specularMapHandle, specularMap);
+	UnloadHandle(normalMapHandle, normalMap);
+	UnloadShader();
+}
 
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+MeshMaterial* TexturedMaterial::Clone() const{
+	TexturedMaterial* clone = new TexturedMaterial(*this);
+	clone->shader = ResourceManager::AddReference(shader);
+	clone->diffuseMap = ResourceManager::AddReference(diffuseMap);
+	clone->specularMap = ResourceManager::AddReference(specularMap);
+	clone->normalMap = ResourceManager::AddReference(normalMap);
+	return clone;
 }
 
 void TexturedMaterial::Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_) const{
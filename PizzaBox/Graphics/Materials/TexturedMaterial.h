@@ -12,6 +12,7 @@ namespace PizzaBox{
 
 		virtual bool Initialize() override;
 		virtual void Destroy() override;
+		virtual MeshMaterial* Clone() const override;
 
 		virtual void Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_) const;
 
@@ -25,9 +26,9 @@ namespace PizzaBox{
 		inline void SetTextureScale(float scale_){ textureScale = scale_; }
 
 	private:
-		std::string diffuseMapName;
-		std::string specularMapName;
-		std::string normalMapName;
+		ResourceHandle<Texture> diffuseMapHandle;
+		ResourceHandle<Texture> specularMapHandle;
+		ResourceHandle<Texture> normalMapHandle;
 		Texture* diffuseMap;
 		Texture* specularMap;
 		Texture* normalMap;
@@ -9,24 +9,16 @@
 using namespace PizzaBox;
 
 WaterMaterial::WaterMaterial(const std::string& diffMap_, const std::string& specMap_, const std::string& normalMap_, float shiny_, float textureScale_, float waterHeight_, int waveAmount_, float amplitude_, float waveLength_, float speed_) : MeshMaterial("WaterShader"), 
-	diffuseMapName(diffMap_), specularMapName(specMap_), specularMap(nullptr), diffuseMap(nullptr), normalMapName(normalMap_), normalMap(nullptr), shininess(shiny_), textureScale(textureScale_), 
-	waterHeight(waterHeight_), waveAmount(waveAmount_), time(0.0f), transparency(0.9f), flowDirection(Vector2()){
+	diffuseMapHandle(ResourceManager::GetHandle<Texture>(diffMap_)), specularMapHandle(), specularMap(nullptr), diffuseMap(nullptr), normalMapHandle(), normalMap(nullptr), shininess(shiny_), textureScale(textureScale_), 
+	waterHeight(waterHeight_), waveAmount(waveAmount_), time(0.0f), transparency(0.9f), flowDirection(Vector2()), wavesGenerated(false){
 
-	_ASSERT(!diffuseMapName.empty());
+	_ASSERT(!diffMap_.empty());
 
 	waveAmount = Math::Clamp(1, 4, waveAmount);
 
-	if(specMap_.empty()){
-		specularMapName = diffuseMapName;
-	}else{
-		specularMapName = specMap_;
-	}
-
-	if(normalMap_.empty()){
-		normalMapName = diffuseMapName;
-	}else{
-		normalMapName = normalMap_;
-	}
+	//The names are only looked up here, loading and unloading goes through the handles after this
+	specularMapHandle = specMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(specMap_);
+	normalMapHandle = normalMap_.empty() ? diffuseMapHandle : ResourceManager::GetHandle<Texture>(normalMap_);
 
 	//Temporarily store the initial values in the list
 	amplitudeList.push_back(amplitude_);
@@ -41,28 +33,17 @@ WaterMaterial::~WaterMaterial(){
 }
 
 bool WaterMaterial::Initialize(){
-	shader = ResourceManager::LoadResource<Shader>(shaderName);
-	if(shader == nullptr){
-		Debug::LogError(shaderName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadShader() == false){
 		return false;
 	}
 
-	diffuseMap = ResourceManager::LoadResource<Texture>(diffuseMapName);
-	if(diffuseMap == nullptr){
-		Debug::LogError(diffuseMapName + " could not be loaded!", __FILE__, __LINE__);
+	if(LoadHandle(diffuseMapHandle, diffuseMap) == false || LoadHandle(specularMapHandle, specularMap) == false || LoadHandle(normalMapHandle, normalMap) == false){
 		return false;
 	}
 
-	specularMap = ResourceManager::LoadResource<Texture>(specularMapName);
-	if(specularMap == nullptr){
-		Debug::LogError(specularMapName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
-	}
-
-	normalMap = ResourceManager::LoadResource<Texture>(normalMapName);
-	if(normalMap == nullptr){
-		Debug::LogError(normalMapName + " could not be loaded!", __FILE__, __LINE__);
-		return false;
+	//Clones come in with their waves already made
+	if(wavesGenerated){
+		return true;
 	}
 
 	//Grab the initial values that we stored in the list and put them into temporary variables
@@ -102,30 +83,26 @@ bool WaterMaterial::Initialize(){
 	}
 	
 	SetWaveParamaters();
+	wavesGenerated = true;
 	
 	return true;
 }
 
 void WaterMaterial::Destroy(){
-	if(diffuseMap != nullptr){
-		ResourceManager::UnloadResource(diffuseMapName);
-		diffuseMap = nullptr;
-	}
-
-	if(specularMap != nullptr){
-		ResourceManager::UnloadResource(specularMapName);
-		specularMap = nullptr;
-	}
-
-	if(normalMap != nullptr){
-		ResourceManager::UnloadResource(normalMapName);
-		normalMap = nullptr;
-	}
+	UnloadHandle(diffuseMapHandle, diffuseMap);
+	UnloadHandle(specularMapHandle, specularMap);
+	UnloadHandle(normalMapHandle, normalMap);
+	UnloadShader();
+}
 
-	if(shader != nullptr){
-		ResourceManager::UnloadResource(shaderName);
-		shader = nullptr;
-	}
+MeshMaterial* WaterMaterial::Clone() const{
+	//The copy keeps this material's waves, which are random
+	WaterMaterial* clone = new WaterMaterial(*this);
+	clone->shader = ResourceManager::AddReference(shader);
+	clone->diffuseMap = ResourceManager::AddReference(diffuseMap);
+	clone->specularMap = ResourceManager::AddReference(specularMap);
+	clone->normalMap = ResourceManager::AddReference(normalMap);
+	return clone;
 }
 
 void WaterMaterial::Update(){
@@ -13,6 +13,7 @@ namespace PizzaBox{
 
 		virtual bool Initialize() override;
 		virtual void Destroy() override;
+		virtual MeshMaterial* Clone() const override;
 
 		virtual void Update() override;
 		virtual void Render(const Camera* camera_, const Matrix4& model_, const std::vector<DirectionalLight*>& dirLights, const std::vector<PointLight*>& pointLights, const std::vector<SpotLight*>& spotLights) const;
@@ -31,9 +32,9 @@ namespace PizzaBox{
 		float waterHeight;
 		int waveAmount;
 		float time;
-		std::string diffuseMapName;
-		std::string specularMapName;
-		std::string normalMapName;
+		ResourceHandle<Texture> diffuseMapHandle;
+		ResourceHandle<Texture> specularMapHandle;
+		ResourceHandle<Texture> normalMapHandle;
 		Texture* diffuseMap;
 		Texture* specularMap;
 		Texture* normalMap;
@@ -45,6 +46,7 @@ namespace PizzaBox{
 		std::vector<float> waveLengthList;
 		std::vector<Vector3> directionList;
 		Vector2 flowDirection;
+		bool wavesGenerated; //The lists only hold the constructor's values until Initialize turns them into waves
 	};
 }
 
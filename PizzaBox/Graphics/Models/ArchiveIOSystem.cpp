@@ -0,0 +1,83 @@
+#include "ArchiveIOSystem.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Core/ResourceArchive.h"
+
+using namespace PizzaBox;
+
+bool ArchiveIOSystem::Exists(const char* file_) const{
+	return ResourceArchive::Contains(file_) || DefaultIOSystem::Exists(file_);
+}
+
+Assimp::IOStream* ArchiveIOSystem::Open(const char* file_, const char* mode_){
+	//Anything that wants to write has to go to disk
+	if(strchr(mode_, 'w') == nullptr && strchr(mode_, 'a') == nullptr){
+		std::vector<char> contents;
+		if(ResourceArchive::ReadEntry(file_, contents)){
+			return new ArchiveIOStream(std::move(contents));
+		}
+	}
+
+	return DefaultIOSystem::Open(file_, mode_);
+}
+
+ArchiveIOStream::ArchiveIOStream(std::vector<char>&& contents_) : contents(std::move(contents_)), position(0){
+}
+
+size_t ArchiveIOStream::Read(void* buffer_, size_t size_, size_t count_){
+	if(size_ == 0){
+		return 0;
+	}
+
+	//Like fread, only whole elements are read
+	const size_t count = std::min(count_, (contents.size() - position) / size_);
+	memcpy(buffer_, contents.data() + position, count * size_);
+	position += count * size_;
+	return count;
+}
+
+size_t ArchiveIOStream::Write(const void* buffer_, size_t size_, size_t count_){
+	return 0;
+}
+
+aiReturn ArchiveIOStream::Seek(size_t offset_, aiOrigin origin_){
+	size_t newPosition = 0;
+	switch(origin_){
+		case aiOrigin_SET:
+			newPosition = offset_;
+			break;
+		case aiOrigin_CUR:
+			newPosition = position + offset_;
+			break;
+		case aiOrigin_END:
+			//AssImp passes the distance back from the end as an unsigned offset
+			if(offset_ > contents.size()){
+				return aiReturn_FAILURE;
+			}
+
+			newPosition = contents.size() - offset_;
+			break;
+		default:
+			return aiReturn_FAILURE;
+	}
+
+	if(newPosition > contents.size()){
+		return aiReturn_FAILURE;
+	}
+
+	position = newPosition;
+	return aiReturn_SUCCESS;
+}
+
+size_t ArchiveIOStream::Tell() const{
+	return position;
+}
+
+size_t ArchiveIOStream::FileSize() const{
+	return contents.size();
+}
+
+void ArchiveIOStream::Flush(){
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef ARCHIVE_IO_SYSTEM_H
+#define ARCHIVE_IO_SYSTEM_H
+
+#include <vector>
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+namespace PizzaBox{
+	//Lets AssImp open models, and whatever files they reference, out of the resource archive
+	//Files that aren't in the archive are opened from disk like AssImp normally would
+	class ArchiveIOSystem : public Assimp::DefaultIOSystem{
+	public:
+		bool Exists(const char* file_) const override;
+		Assimp::IOStream* Open(const char* file_, const char* mode_ = "rb") override;
+	};
+
+	//A read-only stream over an entry that's been read out of the archive
+	class ArchiveIOStream : public Assimp::IOStream{
+	public:
+		explicit ArchiveIOStream(std::vector<char>&& contents_);
+
+		size_t Read(void* buffer_, size_t size_, size_t count_) override;
+		size_t Write(const void* buffer_, size_t size_, size_t count_) override;
+		aiReturn Seek(size_t offset_, aiOrigin origin_) override;
+		size_t Tell() const override;
+		size_t FileSize() const override;
+		void Flush() override;
+
+	private:
+		std::vector<char> contents;
+		size_t position;
+	};
+}
+
+#endif //!ARCHIVE_IO_SYSTEM_H
\ No newline at end of file
@@ -11,6 +11,12 @@
 #include "Math/Vector.h"
 
 namespace PizzaBox{
+	//Vertex data for one mesh, which can be read on any thread and turned into a Mesh on the main thread
+	struct MeshVertexData{
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices;
+	};
+
 	class Mesh{
 	public:
 		Mesh(const std::vector<Vertex>& verts_, const std::vector<unsigned int>& indices_);
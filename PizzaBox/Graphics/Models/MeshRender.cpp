@@ -12,27 +12,27 @@
 
 using namespace PizzaBox;
 
-MeshRender::MeshRender(const std::string& modelName_) : Component(), modelName(modelName_), model(nullptr), materials(), castsShadows(true){
+MeshRender::MeshRender(const std::string& modelName_) : Component(), modelHandle(ResourceManager::GetHandle<Model>(modelName_)), model(nullptr), materials(), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 }
 
-MeshRender::MeshRender(const std::string& modelName_, MeshMaterial* material_) : Component(), modelName(modelName_), model(nullptr), materials(), castsShadows(true){
+MeshRender::MeshRender(const std::string& modelName_, MeshMaterial* material_) : Component(), modelHandle(ResourceManager::GetHandle<Model>(modelName_)), model(nullptr), materials(), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 	_ASSERT(material_ != nullptr);
 	materials.push_back(material_);
 }
 
-MeshRender::MeshRender(const std::string& modelName_, const std::string& textureName_) : Component(), modelName(modelName_), model(nullptr), castsShadows(true){
+MeshRender::MeshRender(const std::string& modelName_, const std::string& textureName_) : Component(), modelHandle(ResourceManager::GetHandle<Model>(modelName_)), model(nullptr), castsShadows(true){
 	_ASSERT(!textureName_.empty());
 	materials.push_back(new TexturedMaterial(textureName_));
 }
 
-MeshRender::MeshRender(const std::string& modelName_, const std::vector<MeshMaterial*>& materials_) : Component(), modelName(modelName_), model(nullptr), materials(materials_), castsShadows(true){
+MeshRender::MeshRender(const std::string& modelName_, const std::vector<MeshMaterial*>& materials_) : Component(), modelHandle(ResourceManager::GetHandle<Model>(modelName_)), model(nullptr), materials(materials_), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 	_ASSERT(!materials_.empty());
 }
 
-MeshRender::MeshRender(const std::string& modelName_, const Color& color_) : Component(), modelName(modelName_), model(nullptr), materials(), castsShadows(true){
+MeshRender::MeshRender(const std::string& modelName_, const Color& color_) : Component(), modelHandle(ResourceManager::GetHandle<Model>(modelName_)), model(nullptr), materials(), castsShadows(true){
 	_ASSERT(!modelName_.empty());
 	materials.push_back(new ColorMaterial(color_));
 }
@@ -56,10 +56,16 @@ bool MeshRender::Initialize(GameObject* go_){
 
 	gameObject = go_;
 
-	model = ResourceManager::LoadResource<Model>(modelName);
+	//Share one import of the model file between the model, its materials and any animation clips
+	ModelLoader::ImportScope importScope;
+
+	//Clones come in with their model already referenced
 	if(model == nullptr){
-		Debug::LogError("Model was not loaded correctly", __FILE__, __LINE__);
-		return false;
+		model = ResourceManager::LoadResource(modelHandle);
+		if(model == nullptr){
+			Debug::LogError("Model was not loaded correctly", __FILE__, __LINE__);
+			return false;
+		}
 	}
 
 	if(materials.empty()){
@@ -85,7 +91,7 @@ void MeshRender::Destroy(){
 	RenderEngine::UnregisterMeshRender(this);
 
 	if(model != nullptr){
-		ResourceManager::UnloadResource(modelName);
+		ResourceManager::UnloadResource(modelHandle);
 		model = nullptr;
 	}
 
@@ -98,6 +104,33 @@ void MeshRender::Destroy(){
 	gameObject = nullptr;
 }
 
+Component* MeshRender::Clone() const{
+	std::vector<MeshMaterial*> materialClones;
+	materialClones.reserve(materials.size());
+	for(const auto& m : materials){
+		MeshMaterial* clone = (m == nullptr) ? nullptr : m->Clone();
+		if(m != nullptr && clone == nullptr){
+			//Every material has to come along, otherwise the copy wouldn't look the same
+			for(auto& c : materialClones){
+				if(c != nullptr){
+					c->Destroy();
+					delete c;
+				}
+			}
+
+			return nullptr;
+		}
+
+		materialClones.push_back(clone);
+	}
+
+	//The copy shares this one's model handle and settings, but gets materials of its own
+	MeshRender* clone = new MeshRender(*this);
+	clone->model = ResourceManager::AddReference(model);
+	clone->materials = materialClones;
+	return clone;
+}
+
 void MeshRender::Render(Camera* camera_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_){
 	//Make sure we're getting a valid Camera pointer
 	_ASSERT(camera_ != nullptr);
@@ -2,6 +2,7 @@
 #define MESH_RENDER_H
 
 #include "Model.h"
+#include "Resource/ResourceHandle.h"
 #include "Graphics/Materials/MeshMaterial.h"
 #include "Object/Component.h"
 
@@ -17,6 +18,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		Component* Clone() const override;
 
 		void Render(Camera* camera_, const std::vector<DirectionalLight*>& dirLights_, const std::vector<PointLight*>& pointLights_, const std::vector<SpotLight*>& spotLights_);
 		void SetMaterial(MeshMaterial* material_, size_t index_ = 0);
@@ -26,7 +28,7 @@ namespace PizzaBox{
 		inline void SetCastsShadows(bool casts_){ castsShadows = casts_; }
 
 	private:
-		std::string modelName;
+		ResourceHandle<Model> modelHandle;
 		Model* model;
 		std::vector<MeshMaterial*> materials;
 		bool castsShadows;
@@ -5,7 +5,7 @@
 
 using namespace PizzaBox;
 
-Model::Model(const std::string filePath_) : Resource(filePath_){
+Model::Model(const std::string filePath_) : Resource(filePath_), decodedMeshes(){
 }
 
 Model::~Model(){
@@ -23,6 +23,28 @@ bool Model::Load(){
 	return true;
 }
 
+bool Model::Decode(){
+	decodedMeshes.clear();
+	if(ModelLoader::DecodeSimpleModel(fileName, decodedMeshes) == false || decodedMeshes.empty()){
+		Debug::LogError(fileName + " could not be loaded!", __FILE__, __LINE__);
+		decodedMeshes.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool Model::Finalize(){
+	meshList = ModelLoader::BuildMeshes(decodedMeshes);
+
+	//The meshes have their own copies now
+	decodedMeshes.clear();
+	decodedMeshes.shrink_to_fit();
+
+	meshList.shrink_to_fit();
+	return !meshList.empty();
+}
+
 void Model::Unload(){
 	for(Mesh* mesh : meshList){
 		delete mesh;
@@ -31,4 +53,14 @@ void Model::Unload(){
 
 	meshList.clear();
 	meshList.shrink_to_fit();
+}
+
+size_t Model::GetByteSize() const{
+	//Meshes keep a copy of their vertices on top of the one in the GPU's buffers
+	size_t size = 0;
+	for(const Mesh* mesh : meshList){
+		size += 2 * ((mesh->vertices.size() * sizeof(Vertex)) + (mesh->indices.size() * sizeof(unsigned int)));
+	}
+
+	return size;
 }
\ No newline at end of file
@@ -14,6 +14,13 @@ namespace PizzaBox{
 
 		bool Load() override;
 		void Unload() override;
+		bool Decode() override;
+		bool Finalize() override;
+		size_t GetByteSize() const override;
+		ResourceType GetType() const override{ return ResourceType::Model; }
+
+	private:
+		std::vector<MeshVertexData> decodedMeshes; //Read by Decode, turned into meshes by Finalize
 	};
 }
 
@@ -1,34 +1,78 @@
 #include "ModelLoader.h"
 
+#include "ArchiveIOSystem.h"
+#include "Core/ResourceArchive.h"
 #include "Graphics/Materials/ColorMaterial.h"
 #include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
 
 using namespace PizzaBox;
 
+constexpr unsigned int ModelLoader::simpleImportFlags;
+constexpr unsigned int ModelLoader::animImportFlags;
+unsigned int ModelLoader::activeScopes = 0;
+std::map<std::pair<std::string, unsigned int>, ModelLoader::ImportedScene*> ModelLoader::importCache;
+
+ModelLoader::ImportScope::ImportScope(){
+	activeScopes++;
+}
+
+ModelLoader::ImportScope::~ImportScope(){
+	_ASSERT(activeScopes > 0);
+
+	activeScopes--;
+	if(activeScopes == 0){
+		ReleaseImportCache();
+	}
+}
+
 std::vector<Mesh*> ModelLoader::LoadSimpleModel(std::string filePath_){
 	std::vector<Mesh*> meshList = std::vector<Mesh*>();
 
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath_, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
-	if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
-		Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(importer.GetErrorString()));
+	const aiScene* scene = ImportScene(filePath_, simpleImportFlags, importer);
+	if(scene == nullptr){
 		//Return the empty mesh list so that we know an error has occured
 		return meshList;
 	}
 	
 	//Recursively process every node of the AssImp scene
-	ProcessSimpleNode(scene->mRootNode, scene, meshList);
-	return meshList;
+	std::vector<MeshVertexData> meshData;
+	ProcessSimpleNode(scene->mRootNode, scene, meshData);
+	return BuildMeshes(meshData);
 }
 
-bool ModelLoader::LoadAnimModel(std::string filePath_, AnimModel& model_){
+bool ModelLoader::DecodeSimpleModel(const std::string& filePath_, std::vector<MeshVertexData>& meshData_){
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath_, aiProcess_ValidateDataStructure | aiProcess_FindInvalidData | aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_LimitBoneWeights);
+	UseArchive(importer);
+	const aiScene* scene = importer.ReadFile(filePath_, simpleImportFlags);
 	if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
 		Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(importer.GetErrorString()));
 		return false;
 	}
 
+	ProcessSimpleNode(scene->mRootNode, scene, meshData_);
+	return true;
+}
+
+std::vector<Mesh*> ModelLoader::BuildMeshes(const std::vector<MeshVertexData>& meshData_){
+	std::vector<Mesh*> meshList = std::vector<Mesh*>();
+	meshList.reserve(meshData_.size());
+
+	for(const MeshVertexData& data : meshData_){
+		meshList.push_back(new Mesh(data.vertices, data.indices));
+	}
+
+	return meshList;
+}
+
+bool ModelLoader::LoadAnimModel(std::string filePath_, AnimModel& model_){
+	Assimp::Importer importer;
+	const aiScene* scene = ImportScene(filePath_, animImportFlags, importer);
+	if(scene == nullptr){
+		return false;
+	}
+
 	Skeleton* skeleton = MakeSkeleton(scene);
 	SkinningData skinningData = LoadSkinningData(skeleton, scene);
 	ProcessAnimNode(scene, model_.meshList, skeleton, skinningData);
@@ -41,9 +85,8 @@ bool ModelLoader::LoadAnimModel(std::string filePath_, AnimModel& model_){
 
 bool ModelLoader::LoadAnimClips(const std::string& filePath_, AnimClip& clip_, unsigned int clipID_){
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath_, aiProcess_ValidateDataStructure | aiProcess_FindInvalidData | aiProcess_ImproveCacheLocality);
-	if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
-		Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(importer.GetErrorString()));
+	const aiScene* scene = ImportScene(filePath_, animImportFlags, importer);
+	if(scene == nullptr){
 		return false;
 	}
 
@@ -87,9 +130,8 @@ std::vector<MeshMaterial*> ModelLoader::LoadMaterials(const std::string& filePat
 	std::vector<MeshMaterial*> materialList = std::vector<MeshMaterial*>();
 
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath_, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
-	if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
-		Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(importer.GetErrorString()));
+	const aiScene* scene = ImportScene(filePath_, animated_ ? animImportFlags : simpleImportFlags, importer);
+	if(scene == nullptr){
 		//Return the empty mesh list so that we know an error has occured
 		return materialList;
 	}
@@ -113,15 +155,76 @@ std::vector<MeshMaterial*> ModelLoader::LoadMaterials(const std::string& filePat
 	return materialList;
 }
 
-void ModelLoader::ProcessSimpleNode(const aiNode* node, const aiScene* scene, std::vector<Mesh*>& meshList_){
+const aiScene* ModelLoader::ImportScene(const std::string& filePath_, unsigned int flags_, Assimp::Importer& localImporter_){
+	//Without an active scope there's nobody to share the scene with, so just import it into the caller's importer
+	if(activeScopes == 0){
+		Debug::StartProfiling("Model Import");
+		UseArchive(localImporter_);
+		const aiScene* scene = localImporter_.ReadFile(filePath_, flags_);
+		Debug::EndProfiling("Model Import");
+		EngineStats::AddToInt("Model Imports", 1);
+
+		if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode){
+			Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(localImporter_.GetErrorString()));
+			return nullptr;
+		}
+
+		return scene;
+	}
+
+	//Only share the import with requests that want exactly the same post processing, anything else gets its own import
+	const auto key = std::make_pair(filePath_, flags_);
+	auto cached = importCache.find(key);
+	if(cached != importCache.end()){
+		EngineStats::AddToInt("Model Import Cache Hits", 1);
+		return cached->second->scene;
+	}
+
+	ImportedScene* imported = new ImportedScene();
+
+	Debug::StartProfiling("Model Import");
+	UseArchive(imported->importer);
+	imported->scene = imported->importer.ReadFile(filePath_, flags_);
+	Debug::EndProfiling("Model Import");
+	EngineStats::AddToInt("Model Imports", 1);
+
+	if(!imported->scene || imported->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !imported->scene->mRootNode){
+		Debug::LogError("AssImp could not load model! AssImp Error: " + std::string(imported->importer.GetErrorString()));
+		delete imported;
+		return nullptr;
+	}
+
+	importCache.insert(std::make_pair(key, imported));
+	return imported->scene;
+}
+
+void ModelLoader::UseArchive(Assimp::Importer& importer_){
+	if(ResourceArchive::IsOpen()){
+		//The importer takes ownership of the IO system
+		importer_.SetIOHandler(new ArchiveIOSystem());
+	}
+}
+
+void ModelLoader::ReleaseImportCache(){
+	for(auto& i : importCache){
+		//Deleting the importer frees the scene along with it
+		delete i.second;
+		i.second = nullptr;
+	}
+
+	importCache.clear();
+}
+
+void ModelLoader::ProcessSimpleNode(const aiNode* node, const aiScene* scene, std::vector<MeshVertexData>& meshData_){
 	//Reserve the appropriate capacity for the number of meshes on this node
-	meshList_.reserve(meshList_.size() + node->mNumMeshes);
+	meshData_.reserve(meshData_.size() + node->mNumMeshes);
 
 	for(unsigned int i = 0; i < node->mNumMeshes; i++){
 		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
 		
-		std::vector<Vertex> verts;
-		std::vector<unsigned int> indices;
+		meshData_.push_back(MeshVertexData());
+		std::vector<Vertex>& verts = meshData_.back().vertices;
+		std::vector<unsigned int>& indices = meshData_.back().indices;
 
 		verts.reserve(mesh->mNumVertices);
 		indices.reserve(mesh->mNumFaces * 3);
@@ -140,11 +243,10 @@ void ModelLoader::ProcessSimpleNode(const aiNode* node, const aiScene* scene, st
 			}
 		}
 
-		meshList_.push_back(new Mesh(verts, indices));
 	}
 	
 	for(unsigned int i = 0; i < node->mNumChildren; i++){
-		ProcessSimpleNode(node->mChildren[i], scene, meshList_);
+		ProcessSimpleNode(node->mChildren[i], scene, meshData_);
 	}
 }
 
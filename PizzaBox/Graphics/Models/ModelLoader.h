@@ -1,6 +1,10 @@
 #ifndef MODEL_LOADER_H
 #define MODEL_LOADER_H
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -13,14 +17,53 @@
 namespace PizzaBox{
 	class ModelLoader{
 	public:
+		//While at least one ImportScope is alive, every file imported through the ModelLoader stays cached
+		//This lets everything that reads a file with the same post processing steps share a single Assimp import
+		//The cached scenes are released when the outermost scope ends
+		class ImportScope{
+		public:
+			ImportScope();
+			~ImportScope();
+
+			//Delete unwanted compiler generated constructors and assignment operators
+			ImportScope(const ImportScope&) = delete;
+			ImportScope(ImportScope&&) = delete;
+			ImportScope& operator=(const ImportScope&) = delete;
+			ImportScope& operator=(ImportScope&&) = delete;
+		};
+
 		static std::vector<Mesh*> LoadSimpleModel(std::string filePath_);
+		//Reads a model without touching OpenGL, the import cache or the profiler, so this is safe to call from a worker thread
+		static bool DecodeSimpleModel(const std::string& filePath_, std::vector<MeshVertexData>& meshData_);
+		static std::vector<Mesh*> BuildMeshes(const std::vector<MeshVertexData>& meshData_);
 		static bool LoadAnimModel(std::string filePath_, AnimModel& model_);
 		static bool LoadAnimClips(const std::string& filePath_, AnimClip& clip_, unsigned int clipID_ = 0);
 
 		static std::vector<MeshMaterial*> LoadMaterials(const std::string& filePath_, bool animated_);
 
 	private:
-		static void ProcessSimpleNode(const aiNode* node, const aiScene* scene, std::vector<Mesh*>& meshList_);
+		struct ImportedScene{
+			ImportedScene() : importer(), scene(nullptr){}
+
+			Assimp::Importer importer;
+			const aiScene* scene;
+		};
+
+		//Materials and animation clips are read with the same steps as the model they belong to, so they can come out of the same import
+		//The mesh steps in animImportFlags don't change animation data, clips just don't need them
+		static constexpr unsigned int simpleImportFlags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices;
+		static constexpr unsigned int animImportFlags = aiProcess_ValidateDataStructure | aiProcess_FindInvalidData | aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_LimitBoneWeights;
+
+		static unsigned int activeScopes;
+		//Keyed on the file and its post processing flags, since the same file imported with different steps is a different scene
+		static std::map<std::pair<std::string, unsigned int>, ImportedScene*> importCache;
+
+		static const aiScene* ImportScene(const std::string& filePath_, unsigned int flags_, Assimp::Importer& localImporter_);
+		static void ReleaseImportCache();
+		//Points the importer at the resource archive when there is one
+		static void UseArchive(Assimp::Importer& importer_);
+
+		static void ProcessSimpleNode(const aiNode* node, const aiScene* scene, std::vector<MeshVertexData>& meshData_);
 		static void ProcessAnimNode(const aiScene* scene_, std::vector<AnimMesh*>& meshList_, Skeleton* skeleton_, const SkinningData& data_);
 		static Skeleton* MakeSkeleton(const aiScene* scene_);
 		static SkinningData LoadSkinningData(Skeleton* skeleton_, const aiScene* scene_);
@@ -167,6 +167,23 @@ void ParticleSystem::Destroy(){
 	gameObject = nullptr;
 }
 
+Component* ParticleSystem::Clone() const{
+	//The copy starts with no particles, its buffers and uniforms are set up when it's initialized
+	ParticleSystem* clone = new ParticleSystem((texture == nullptr) ? nullptr : new ParticleTexture(*texture), particleSpawnRate, initialSpeed, gravityScale, lifeLength, shaderName);
+	clone->SetEnable(GetEnable());
+	clone->positionOffset = positionOffset;
+	clone->rotationOffset = rotationOffset;
+	clone->rotation = rotation;
+	clone->scale = scale;
+	clone->dirX = dirX;
+	clone->dirY = dirY;
+	clone->dirZ = dirZ;
+	clone->velocityChange = velocityChange;
+	clone->sizeChange = sizeChange;
+	clone->rotationChange = rotationChange;
+	return clone;
+}
+
 void ParticleSystem::Update(){
 	GenerateParticle();
 
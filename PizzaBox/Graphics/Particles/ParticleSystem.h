@@ -21,6 +21,7 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		Component* Clone() const override;
 
 		void Update();
 		void Render(const Camera* camera_);
@@ -25,6 +25,9 @@ ParticleTexture::ParticleTexture(const std::string& filePath_, int numOfTexture_
 	}
 }
 
+ParticleTexture::ParticleTexture(const ParticleTexture& other_) : textureName(other_.textureName), texture(ResourceManager::AddReference(other_.texture)), numOfTexture(other_.numOfTexture){
+}
+
 ParticleTexture::~ParticleTexture(){
 	ResourceManager::UnloadResource(textureName);
 }
\ No newline at end of file
@@ -11,6 +11,9 @@ namespace PizzaBox{
 	class ParticleTexture{
 	public:
 		ParticleTexture(const std::string& filePath_, int numOfTexture_);
+		//A copy takes another reference to the same texture rather than loading it again
+		ParticleTexture(const ParticleTexture& other_);
+		ParticleTexture& operator=(const ParticleTexture&) = delete;
 		~ParticleTexture();
 
 		inline GLuint GetTexture() const { return texture->TextureID(); }
@@ -38,6 +38,8 @@ std::vector<PointLight*> RenderEngine::points;
 std::vector<SpotLight*> RenderEngine::spots;
 std::vector<ParticleSystem*> RenderEngine::pSystems;
 std::vector<AnimMeshRender*> RenderEngine::animMeshRenders;
+bool RenderEngine::isBatchingUnregisters = false;
+std::unordered_set<MeshRender*> RenderEngine::batchedMeshRenders;
 std::string RenderEngine::sharedShaderName = "Resources/Shaders/_shared.glsl";
 std::string RenderEngine::sharedShaderCode = "";
 
@@ -417,9 +419,19 @@ void RenderEngine::RegisterCamera(Camera* cam_){
 
 void RenderEngine::RegisterMeshRender(MeshRender* mr_){
 	_ASSERT(mr_ != nullptr);
+	//A new MeshRender could have the address of one that's waiting to be taken out, so take those out first
+	if(!batchedMeshRenders.empty()){
+		UnregisterMeshRenders(batchedMeshRenders);
+		batchedMeshRenders.clear();
+	}
+
 	mrs.push_back(mr_);
 }
 
+void RenderEngine::ReserveMeshRenders(size_t count_){
+	mrs.reserve(mrs.size() + count_);
+}
+
 void RenderEngine::RegisterTextRender(TextRender* tr_){
 	_ASSERT(tr_ != nullptr);
 	trs.push_back(tr_);
@@ -457,9 +469,35 @@ void RenderEngine::UnregisterCamera(Camera* cam_){
 
 void RenderEngine::UnregisterMeshRender(MeshRender* mr_){
 	_ASSERT(mr_ != nullptr);
+	if(isBatchingUnregisters){
+		batchedMeshRenders.insert(mr_);
+		return;
+	}
+
 	mrs.erase(std::remove(mrs.begin(), mrs.end(), mr_), mrs.end());
 }
 
+void RenderEngine::BeginBatchUnregister(){
+	_ASSERT(!isBatchingUnregisters);
+	isBatchingUnregisters = true;
+}
+
+void RenderEngine::EndBatchUnregister(){
+	_ASSERT(isBatchingUnregisters);
+	isBatchingUnregisters = false;
+
+	UnregisterMeshRenders(batchedMeshRenders);
+	batchedMeshRenders.clear();
+}
+
+void RenderEngine::UnregisterMeshRenders(const std::unordered_set<MeshRender*>& mrs_){
+	if(mrs_.empty()){
+		return;
+	}
+
+	mrs.erase(std::remove_if(mrs.begin(), mrs.end(), [&mrs_](MeshRender* mr_){ return mrs_.find(mr_) != mrs_.end(); }), mrs.end());
+}
+
 void RenderEngine::UnregisterTextRender(TextRender* tr_){
 	_ASSERT(tr_ != nullptr);
 	trs.erase(std::remove(trs.begin(), trs.end(), tr_), trs.end());
@@ -1,6 +1,7 @@
 #ifndef RENDER_ENGINE_H
 #define RENDER_ENGINE_H
 
+#include <unordered_set>
 #include <vector>
 
 #include "Camera.h"
@@ -30,7 +31,7 @@ namespace PizzaBox{
 		static bool GetWindowBorderless();
 		static Window::VSYNC GetVSYNC();
 		static bool IsShowingCursor(){ return isShowingCursor; }
-		inline static std::string GetSharedShaderCode(){ return sharedShaderCode; }
+		inline static const std::string& GetSharedShaderCode(){ return sharedShaderCode; }
 
 		static void OnResize(int w_, int h_);
 		static void SetWindowFullscreen(bool fullscreen_);
@@ -42,6 +43,8 @@ namespace PizzaBox{
 
 		static void RegisterCamera(Camera* cam_);
 		static void RegisterMeshRender(MeshRender* mr_);
+		//Makes room for this many more MeshRenders before a batch of them registers
+		static void ReserveMeshRenders(size_t count_);
 		static void RegisterTextRender(TextRender* tr_);
 		static void RegisterDirectionalLight(DirectionalLight* dir_);
 		static void RegisterPointLight(PointLight* point_);
@@ -57,6 +60,10 @@ namespace PizzaBox{
 		static void UnregisterSpotLight(SpotLight* spot_);
 		static void UnregisterParticleSystem(ParticleSystem* sys_);
 		static void UnregisterAnimMeshRender(AnimMeshRender* amr_);
+		//MeshRenders unregistered between these two calls are all taken out of the list in one pass, for destroying objects in bulk
+		static void BeginBatchUnregister();
+		static void EndBatchUnregister();
+		static void UnregisterMeshRenders(const std::unordered_set<MeshRender*>& mrs_);
 
 		static Color baseAmbient;
 		
@@ -90,6 +97,8 @@ namespace PizzaBox{
 		static std::vector<SpotLight*> spots;
 		static std::vector<ParticleSystem*> pSystems;
 		static std::vector<AnimMeshRender*> animMeshRenders;
+		static bool isBatchingUnregisters;
+		static std::unordered_set<MeshRender*> batchedMeshRenders;
 
 		static Window* window;
 		static MultisampleFBO* multisampleFBO;
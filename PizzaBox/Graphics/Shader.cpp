@@ -11,6 +11,7 @@
 #include "LowLevel/Uniform.h"
 
 #include "Core/FileSystem.h"
+#include "Core/MappedFile.h"
 #include "Graphics/Color.h"
 #include "Math/Matrix.h"
 #include "Math/Vector.h"
@@ -22,17 +23,17 @@ int Shader::maxTextureUnits = 0;
 
 //Vertex and Fragment Shader filenames, then the number of attributes (in pairs)
 //The pair consists of an index and a name
-Shader::Shader(const std::string& vertPath_, const std::string& fragPath_) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), uniforms(), currentBoundTextures(0){
+Shader::Shader(const std::string& vertPath_, const std::string& fragPath_) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), byteSize(0), uniforms(), currentBoundTextures(0){
 	_ASSERT(FileSystem::FileExists(fileName));
 	_ASSERT(FileSystem::FileExists(fragmentFileName));
 }
 
-Shader::Shader(const std::string& vertPath_, const std::string& fragPath_, int numAttributes_, ...) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), uniforms(), currentBoundTextures(0){
+Shader::Shader(const std::string& vertPath_, const std::string& fragPath_, int numAttributes_, ...) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), byteSize(0), uniforms(), currentBoundTextures(0){
 	_ASSERT(FileSystem::FileExists(fileName));
 	_ASSERT(FileSystem::FileExists(fragmentFileName));
 }
 
-Shader::Shader(const std::string& vertPath_, const std::string& fragPath_, const std::vector<std::string>& args_) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), uniforms(), currentBoundTextures(0){
+Shader::Shader(const std::string& vertPath_, const std::string& fragPath_, const std::vector<std::string>& args_) : Resource(vertPath_), fragmentFileName(fragPath_), shader(0), byteSize(0), uniforms(), currentBoundTextures(0){
 	_ASSERT(FileSystem::FileExists(fileName));
 	_ASSERT(FileSystem::FileExists(fragmentFileName));
 }
@@ -41,29 +42,17 @@ Shader::~Shader(){
 }
 
 bool Shader::Load(){
-	std::string vString = FileSystem::ReadFileToString(fileName);
-	std::string fString = FileSystem::ReadFileToString(fragmentFileName);
-
-	//Add in code shared by all shaders if include directive is found
-	std::string toReplace = "#include \"_shared.glsl\"";
-	size_t pos = vString.find(toReplace);
-	if(pos != std::string::npos){
-		vString = vString.replace(pos, toReplace.size(), RenderEngine::GetSharedShaderCode());
-	}
-
-	pos = fString.find(toReplace);
-	if(pos != std::string::npos){
-		fString = fString.replace(pos, toReplace.size(), RenderEngine::GetSharedShaderCode());
-	}
+	const MappedFile vFile(fileName);
+	const MappedFile fFile(fragmentFileName);
 
-	if(vString.empty() || fString.empty()){
+	if(vFile.Size() == 0 || fFile.Size() == 0){
 		Debug::LogError("Could not load shader files!", __FILE__, __LINE__);
 		return false;
 	}
 
-	//Our shader code needs to be stored in a const char* to be passed to OpenGL
-	const char* vsText = vString.c_str();
-	const char* fsText = fString.c_str();
+	//OpenGL takes the source in pieces, so the shared code is passed in place of its include directive instead of being spliced into a copy
+	const ShaderSource vSource = SplitSource(vFile.View());
+	const ShaderSource fSource = SplitSource(fFile.View());
 
 	//GL_VERTEX_SHADER and GL_FRAGMENT_SHADER are defined in glew.h
 	GLuint vertShader = glCreateShader(GL_VERTEX_SHADER);
@@ -75,8 +64,8 @@ bool Shader::Load(){
 		return false;
 	}
 
-	glShaderSource(vertShader, 1, &vsText, 0);
-	glShaderSource(fragShader, 1, &fsText, 0);
+	glShaderSource(vertShader, vSource.count, vSource.pieces, vSource.lengths);
+	glShaderSource(fragShader, fSource.count, fSource.pieces, fSource.lengths);
 
 	glCompileShader(vertShader);
 	//Check for errors
@@ -153,6 +142,9 @@ bool Shader::Load(){
 		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
 	}
 
+	//There's no portable way to ask how big the compiled program is, so the source it was built from stands in for it
+	byteSize = vFile.Size() + fFile.Size() + (uniforms.size() * sizeof(Uniform));
+
 	return true;
 }
 
@@ -163,6 +155,7 @@ void Shader::Unload(){
 	}
 
 	uniforms.clear();
+	byteSize = 0;
 
 	if(shader != 0){
 		glDeleteProgram(shader);
@@ -170,6 +163,30 @@ void Shader::Unload(){
 	}
 }
 
+Shader::ShaderSource Shader::SplitSource(StringView source_){
+	static const StringView includeDirective = "#include \"_shared.glsl\"";
+	const std::string& sharedCode = RenderEngine::GetSharedShaderCode();
+
+	ShaderSource result;
+	const size_t pos = source_.find(includeDirective);
+	if(pos == StringView::npos){
+		result.count = 1;
+		result.pieces[0] = source_.data();
+		result.lengths[0] = static_cast<GLint>(source_.size());
+		return result;
+	}
+
+	const StringView after = source_.substr(pos + includeDirective.size());
+	result.count = 3;
+	result.pieces[0] = source_.data();
+	result.lengths[0] = static_cast<GLint>(pos);
+	result.pieces[1] = sharedCode.data();
+	result.lengths[1] = static_cast<GLint>(sharedCode.size());
+	result.pieces[2] = after.data();
+	result.lengths[2] = static_cast<GLint>(after.size());
+	return result;
+}
+
 std::string Shader::GetShaderLog(GLuint shader_){
 	std::string errorLog;
 
@@ -7,10 +7,12 @@
 #include <vector>
 
 #include "LowLevel/Uniform.h"
+#include "Core/StringView.h"
 #include "Resource/Resource.h"
 
 //Forward Declaration
 typedef unsigned int GLuint;
+typedef int GLint;
 
 namespace PizzaBox{
 	//Forward Declarations
@@ -32,6 +34,7 @@ namespace PizzaBox{
 
 		bool Load() override;
 		void Unload() override;
+		size_t GetByteSize() const override{ return byteSize; }
 
 		unsigned int Program() const;
 		void Use();
@@ -86,14 +89,24 @@ namespace PizzaBox{
 		static std::string GetShaderLog(GLuint shader_);
 
 	private:
+		//Up to three pieces of source, the code before the shared include, the shared code itself and the code after it
+		struct ShaderSource{
+			int count;
+			const char* pieces[3];
+			GLint lengths[3];
+		};
+
 		std::string fragmentFileName;
 		GLuint shader;
+		size_t byteSize;
 
 		std::unordered_map<std::string, Uniform*> uniforms;
 		int currentBoundTextures;
 
 		static int maxTextureUnits;
 
+		static ShaderSource SplitSource(StringView source_);
+
 		Shader(const Shader&) = delete;
 		Shader(Shader&&) = delete;
 		Shader& operator = (const Shader&) = delete;
@@ -4,17 +4,24 @@
 
 #include <SDL_image.h>
 
+#include "../Texture.h"
 #include "../../Tools/Debug.h"
 
 using namespace PizzaBox;
 
-SkyBoxResource::SkyBoxResource(const std::string fileName_) : Resource(fileName_), textureID(0){
+SkyBoxResource::SkyBoxResource(const std::string fileName_) : Resource(fileName_), textureID(0), byteSize(0), decodedFaces(){
 }
 
 SkyBoxResource::~SkyBoxResource(){
+	//A load that was decoded but never finalized still has its images
+	ReleaseDecodedFaces();
 } 
 
 bool SkyBoxResource::Load(){
+	return Decode() && Finalize();
+}
+
+bool SkyBoxResource::Decode(){
 	std::vector<std::string> faces = {
 		fileName + "/right.png",
 		fileName + "/left.png",
@@ -24,40 +31,57 @@ bool SkyBoxResource::Load(){
 		fileName + "/front.png"
 	};
 
-	glGenTextures(1, &textureID);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+	ReleaseDecodedFaces();
+	decodedFaces.reserve(faces.size());
 
-	int mode;
-	int precision;
 	int expectedBytes;
 	for (GLuint i = 0; i < faces.size(); i++) {
-		SDL_Surface* image = IMG_Load(faces[i].c_str());
+		SDL_Surface* image = Texture::ReadImage(faces[i]);
 		if(image == nullptr){
 			Debug::LogError("Could not load image " + faces[i] + "!", __FILE__, __LINE__);
+			ReleaseDecodedFaces();
 			return false;
 		}
 
+		decodedFaces.push_back(image);
+
 		//This is the first runthrough of the loop, we want to set the mode
 		if(i == 0){
-			//Use alpha if the image supports it, otherwise don't
 			expectedBytes = image->format->BytesPerPixel;
-			mode = (expectedBytes == 4) ? GL_RGBA : GL_RGB;
-			precision = (expectedBytes == 4) ? GL_RGBA8 : GL_RGB8;
-			
 		}else{
 			//On any other run of the loop we just want to compare
 			if(image->format->BytesPerPixel != expectedBytes){
 				Debug::LogError("Skybox images have inconsistent bit depths! Was expecting a bit depth of " +
 					std::to_string(expectedBytes) + " on " + faces[i] + "!", __FILE__, __LINE__
 				);
+				ReleaseDecodedFaces();
 				return false;
 			}
 		}
+	}
+
+	return true;
+}
+
+bool SkyBoxResource::Finalize(){
+	_ASSERT(!decodedFaces.empty());
 
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, precision, image->w, image->h, 0, mode, GL_UNSIGNED_BYTE, image->pixels);
-		SDL_FreeSurface(image);
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+
+	//Use alpha if the images support it, otherwise don't
+	//Decode already made sure every face has the same bit depth
+	const int mode = (decodedFaces.front()->format->BytesPerPixel == 4) ? GL_RGBA : GL_RGB;
+	const int precision = (decodedFaces.front()->format->BytesPerPixel == 4) ? GL_RGBA8 : GL_RGB8;
+
+	byteSize = 0;
+	for (GLuint i = 0; i < decodedFaces.size(); i++) {
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, precision, decodedFaces[i]->w, decodedFaces[i]->h, 0, mode, GL_UNSIGNED_BYTE, decodedFaces[i]->pixels);
+		byteSize += static_cast<size_t>(decodedFaces[i]->w) * decodedFaces[i]->h * decodedFaces[i]->format->BytesPerPixel;
 	}
 
+	ReleaseDecodedFaces();
+
 	//Texture filters
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -70,4 +94,14 @@ bool SkyBoxResource::Load(){
 
 void SkyBoxResource::Unload(){
 	glDeleteTextures(1, &textureID);
+	textureID = 0; //Profiles unload their resource again when they're deleted, and this name could belong to another texture by then
+	byteSize = 0;
+}
+
+void SkyBoxResource::ReleaseDecodedFaces(){
+	for(SDL_Surface* face : decodedFaces){
+		SDL_FreeSurface(face);
+	}
+
+	decodedFaces.clear();
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #ifndef SKY_BOX_RESOURCE_H
 #define SKY_BOX_RESOURCE_H
 
+#include <vector>
+
 #include <glew.h>
 
 #include "../../Resource/Resource.h"
 
+struct SDL_Surface;
+
 namespace PizzaBox{
 	class SkyBoxResource : public Resource{
 	public:
@@ -13,6 +17,11 @@ namespace PizzaBox{
 
 		bool Load() override;
 		void Unload() override;
+		bool Decode() override;
+		bool Finalize() override;
+
+		size_t GetByteSize() const override{ return byteSize; }
+		ResourceType GetType() const override{ return ResourceType::Texture; }
 
 		GLuint TextureID() const{
 			return textureID;
@@ -20,6 +29,10 @@ namespace PizzaBox{
 
 	private:
 		GLuint textureID;
+		size_t byteSize;
+		std::vector<SDL_Surface*> decodedFaces; //The images read by Decode, waiting to be uploaded by Finalize
+
+		void ReleaseDecodedFaces();
 	};
 }
 
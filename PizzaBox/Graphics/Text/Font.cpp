@@ -27,6 +27,16 @@ void Font::Unload(){
 	}
 }
 
+size_t Font::GetByteSize() const{
+	//Each glyph has its own single channel texture
+	size_t size = 0;
+	for(const auto& c : characters){
+		size += sizeof(FontCharacter) + static_cast<size_t>(c.second.sizeX) * static_cast<size_t>(c.second.sizeY);
+	}
+
+	return size;
+}
+
 std::map<char, FontCharacter>& Font::Characters(){
 	return characters;
 }
\ No newline at end of file
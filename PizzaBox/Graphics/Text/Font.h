@@ -14,6 +14,7 @@ namespace PizzaBox{
 
 		bool Load() override;
 		void Unload() override;
+		size_t GetByteSize() const override;
 
 		std::map<char, FontCharacter>& Characters();
 	private:
@@ -1,5 +1,8 @@
 #include "FontEngine.h"
 
+#include <vector>
+
+#include "../../Core/ResourceArchive.h"
 #include "../../Tools/Debug.h"
 
 using namespace PizzaBox;
@@ -40,7 +43,15 @@ std::map<char, FontCharacter> FontEngine::LoadFont(const std::string fontPath_){
 	std::map<char, FontCharacter> characters = std::map<char, FontCharacter>();
 
 	//Attempt to initialize the font face
-	FT_Error err = FT_New_Face(ftLib, fontPath_.c_str(), 0, &fontFace);
+	//A face made from memory reads from it until FT_Done_Face, so the archived copy has to stay around until the end of this function
+	std::vector<char> archived;
+	FT_Error err = FT_Err_Ok;
+	if(ResourceArchive::ReadEntry(fontPath_, archived)){
+		err = FT_New_Memory_Face(ftLib, reinterpret_cast<const FT_Byte*>(archived.data()), static_cast<FT_Long>(archived.size()), 0, &fontFace);
+	}else{
+		err = FT_New_Face(ftLib, fontPath_.c_str(), 0, &fontFace);
+	}
+
 	if(err != FT_Err_Ok){
 		Debug::LogError("Could not load font face! FreeType Error Code: " + std::to_string(err));
 		characters.clear();
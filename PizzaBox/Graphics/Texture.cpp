@@ -1,19 +1,44 @@
 #include "Texture.h"
 
+#include <vector>
+
 #include <SDL_Image.h>
 #include <glew.h>
 
+#include "Core/ResourceArchive.h"
 #include "Tools/Debug.h"
 
 using namespace PizzaBox;
 
-Texture::Texture(const std::string filePath) : Resource(filePath), textureID(0){
+Texture::Texture(const std::string filePath) : Resource(filePath), textureID(0), byteSize(0), decodedSurface(nullptr){
 }
 
 Texture::~Texture(){
+	//A load that was decoded but never finalized still has its image
+	if(decodedSurface != nullptr){
+		SDL_FreeSurface(decodedSurface);
+		decodedSurface = nullptr;
+	}
 }
 
 bool Texture::Load(){
+	return Decode() && Finalize();
+}
+
+bool Texture::Decode(){
+	//Load in the texture from the source file
+	decodedSurface = ReadImage(fileName);
+	if(decodedSurface == nullptr){
+		Debug::LogError(SDL_GetError(), __FILE__, __LINE__);
+		return false;
+	}
+
+	return true;
+}
+
+bool Texture::Finalize(){
+	_ASSERT(decodedSurface != nullptr);
+
 	//Generate the Texture in OpenGL and get the ID
 	glGenTextures(1, &textureID);
 	//Bind the generated texture
@@ -22,16 +47,9 @@ bool Texture::Load(){
 
 	glGenerateMipmap(GL_TEXTURE_2D);
 
-	//Load in the texture from the source file
-	SDL_Surface* textureSurface = IMG_Load(fileName.c_str());
-	if(textureSurface == nullptr){
-		Debug::LogError(SDL_GetError(), __FILE__, __LINE__);
-		return false;
-	}
-
 	//Use alpha if the image supports it, otherwise don't
-	int mode = (textureSurface->format->BytesPerPixel == 4) ? GL_RGBA : GL_RGB;
-	int precision = (textureSurface->format->BytesPerPixel == 4) ? GL_RGBA8 : GL_RGB8;
+	int mode = (decodedSurface->format->BytesPerPixel == 4) ? GL_RGBA : GL_RGB;
+	int precision = (decodedSurface->format->BytesPerPixel == 4) ? GL_RGBA8 : GL_RGB8;
 
 	//Wrapping and filtering options
 	//glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -42,20 +60,36 @@ bool Texture::Load(){
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	
 	//Load the texture data from the SDL_Surface to the GPU memmory
-	glTexImage2D(GL_TEXTURE_2D, 0, precision, textureSurface->w, textureSurface->h, 0, mode, GL_UNSIGNED_BYTE, textureSurface->pixels);
+	glTexImage2D(GL_TEXTURE_2D, 0, precision, decodedSurface->w, decodedSurface->h, 0, mode, GL_UNSIGNED_BYTE, decodedSurface->pixels);
 	glGenerateMipmap(GL_TEXTURE_2D);
+
+	//The mipmap chain adds roughly another third on top of the base image
+	const size_t baseSize = static_cast<size_t>(decodedSurface->w) * decodedSurface->h * decodedSurface->format->BytesPerPixel;
+	byteSize = baseSize + (baseSize / 3);
 	
 	//Release the memory
-	SDL_FreeSurface(textureSurface);
-	textureSurface = nullptr;
+	SDL_FreeSurface(decodedSurface);
+	decodedSurface = nullptr;
 	
 	return true;
 }
 
 void Texture::Unload(){
 	glDeleteTextures(1, &textureID);
+	textureID = 0; //Profiles unload their resource again when they're deleted, and this name could belong to another texture by then
+	byteSize = 0;
 }
 
 GLuint Texture::TextureID(){
 	return textureID;
+}
+
+SDL_Surface* Texture::ReadImage(const std::string& file_){
+	std::vector<char> archived;
+	if(ResourceArchive::ReadEntry(file_, archived)){
+		//IMG_Load_RW decodes the whole image before returning, so the buffer doesn't have to outlive this call
+		return IMG_Load_RW(SDL_RWFromConstMem(archived.data(), static_cast<int>(archived.size())), 1);
+	}
+
+	return IMG_Load(file_.c_str());
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #include "../Resource/Resource.h"
 
+struct SDL_Surface;
+
 namespace PizzaBox{
 	class Texture : public Resource{
 	public:
@@ -15,10 +17,22 @@ namespace PizzaBox{
 
 		bool Load();
 		void Unload();
+		bool Decode() override;
+		bool Finalize() override;
+
+		size_t GetByteSize() const override{ return byteSize; }
+		ResourceType GetType() const override{ return ResourceType::Texture; }
 
 		GLuint TextureID();
+
+		//Reads an image from the resource archive if it's in there, otherwise from disk
+		//Safe to call from a worker thread, returns nullptr and sets SDL's error if the image couldn't be read
+		static SDL_Surface* ReadImage(const std::string& file_);
+
 	private:
 		GLuint textureID;
+		size_t byteSize;
+		SDL_Surface* decodedSurface; //The image read by Decode, waiting to be uploaded by Finalize
 	};
 }
 
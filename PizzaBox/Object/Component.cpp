@@ -6,6 +6,9 @@
 
 using namespace PizzaBox;
 
+//Initialize static variables here
+constexpr unsigned int ComponentTypeID::maxTypes;
+
 //Suppress meaningless and unavoidable warning
 #pragma warning( push )
 #pragma warning( disable : 26444 )
@@ -15,6 +18,44 @@ RTTR_REGISTRATION{
 		.method("Destroy", &Component::Destroy)
 		.method("GetEnable", &Component::GetEnable)
 		.method("GetGameObject", &Component::GetGameObject)
-		.method("SetEnable", &Component::SetEnable);
+		.method("SetEnable", &Component::SetEnable)
+		.method("GetHandle", &Component::GetHandle);
+
+	rttr::registration::class_<ComponentHandle>("ComponentHandle")
+		.constructor()
+		.method("Get", &ComponentHandle::Get)
+		.method("IsValid", &ComponentHandle::IsValid);
+}
+#pragma warning( pop )
+
+unsigned int ComponentTypeID::Count(){
+	return static_cast<unsigned int>(GetRegistry().types.size());
+}
+
+const ComponentTypeID::Mask& ComponentTypeID::MaskOf(const Component* component_){
+	_ASSERT(component_ != nullptr);
+	Registry& registry = GetRegistry();
+
+	TypeMask& typeMask = registry.masks[std::type_index(typeid(*component_))];
+	const unsigned int typeCount = static_cast<unsigned int>(registry.types.size());
+	for(unsigned int i = typeMask.typesChecked; i < typeCount && i < maxTypes; i++){
+		typeMask.mask.set(i, registry.types[i](component_));
+	}
+
+	typeMask.typesChecked = typeCount;
+	return typeMask.mask;
+}
+
+unsigned int ComponentTypeID::Register(TypeCheck isType_){
+	Registry& registry = GetRegistry();
+	//Types past the end of the mask would never be found, so raise maxTypes if this is hit
+	_ASSERT(registry.types.size() < maxTypes);
+
+	registry.types.push_back(isType_);
+	return static_cast<unsigned int>(registry.types.size() - 1);
 }
-#pragma warning( pop )
\ No newline at end of file
+
+ComponentTypeID::Registry& ComponentTypeID::GetRegistry(){
+	static Registry registry;
+	return registry;
+}
\ No newline at end of file
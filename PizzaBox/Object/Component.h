@@ -1,15 +1,37 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+#include <bitset>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "Handle.h"
+#include "ObjectPool.h"
+
 namespace PizzaBox{
+	class Component;
+	using ComponentHandle = Handle<Component>;
+
 	class Component{
 	public:
-		Component() : gameObject(nullptr), enabled(true){};
-		virtual ~Component(){};
+		Component() : gameObject(nullptr), enabled(true), handleIndex(HandleTable<Component>::Add(this)){};
+		//Copies start out unattached and get a handle of their own
+		Component(const Component& other_) : gameObject(nullptr), enabled(other_.enabled), handleIndex(HandleTable<Component>::Add(this)){};
+		Component& operator=(const Component&) = delete;
+		virtual ~Component(){ HandleTable<Component>::Remove(handleIndex); };
+
+		//Components are allocated from the ObjectPool, the virtual destructor makes sure the right size comes back here for derived types
+		static void* operator new(size_t size_){ return ObjectPool::Allocate(size_); }
+		static void operator delete(void* block_, size_t size_){ ObjectPool::Free(block_, size_); }
 
 		virtual bool Initialize(class GameObject* go_) = 0;
 		virtual void Destroy() = 0;
 
+		//Makes an uninitialized copy of this component's settings for prefabs, components that can't be copied return nullptr
+		virtual Component* Clone() const{ return nullptr; }
+
 		bool GetEnable() const{
 			return enabled;
 		}
@@ -21,10 +43,72 @@ namespace PizzaBox{
 		void SetEnable(const bool enable_){
 			enabled = enable_;
 		}
+
+		ComponentHandle GetHandle() const{
+			return ComponentHandle(handleIndex, HandleTable<Component>::Generation(handleIndex));
+		}
 	protected:
 		class GameObject* gameObject; //The GameObject that this component is attached to
 		bool enabled; //Is this component enabled?
+
+	private:
+		unsigned int handleIndex;
+	};
+
+	//Every component type that gets looked up anywhere in the program is given a small ID when the program starts
+	//Each concrete type then gets a mask of every registered type it is, base classes like Script and Component included
+	//That mask is worked out once per concrete type, so adding, removing and finding components never needs a dynamic_cast
+	class ComponentTypeID{
+	public:
+		static constexpr unsigned int maxTypes = 128;
+		using Mask = std::bitset<maxTypes>;
+
+		template <class T> static unsigned int Get(){
+			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+			return Registration<T>::id;
+		}
+
+		static unsigned int Count();
+		static const Mask& MaskOf(const Component* component_);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		ComponentTypeID() = delete;
+		ComponentTypeID(const ComponentTypeID&) = delete;
+		ComponentTypeID(ComponentTypeID&&) = delete;
+		ComponentTypeID& operator=(const ComponentTypeID&) = delete;
+		ComponentTypeID& operator=(ComponentTypeID&&) = delete;
+		~ComponentTypeID() = delete;
+
+	private:
+		using TypeCheck = bool (*)(const Component*);
+
+		struct TypeMask{
+			TypeMask() : mask(), typesChecked(0){}
+
+			Mask mask;
+			unsigned int typesChecked; //Types registered after the mask was made are checked the next time it's asked for
+		};
+
+		struct Registry{
+			std::vector<TypeCheck> types; //Indexed by ID
+			std::unordered_map<std::type_index, TypeMask> masks; //One per concrete type
+		};
+
+		//Static data members of a class template are initialized when the program starts, which is what registers T
+		template <class T> struct Registration{
+			static const unsigned int id;
+		};
+
+		template <class T> static bool IsType(const Component* component_){
+			return dynamic_cast<const T*>(component_) != nullptr;
+		}
+
+		static unsigned int Register(TypeCheck isType_);
+		//Registration happens during static initialization, so the registry is made the first time it's needed rather than relying on the order of initialization
+		static Registry& GetRegistry();
 	};
+
+	template <class T> const unsigned int ComponentTypeID::Registration<T>::id = ComponentTypeID::Register(&ComponentTypeID::IsType<T>);
 }
 
 #endif //!COMPONENT_H
\ No newline at end of file
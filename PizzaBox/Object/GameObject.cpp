@@ -1,13 +1,20 @@
 #include "GameObject.h"
 
+#include <algorithm>
+
 #include <rttr/registration.h>
 
 #include "Core/GameManager.h"
 #include "Core/SceneManager.h"
+#include "Object/TagTable.h"
+#include "Script/Script.h"
 #include "Tools/Debug.h"
 
 using namespace PizzaBox;
 
+//Initialize static variables here
+const std::vector<Component*> GameObject::noComponents;
+
 //Suppress meaningless and unavoidable warning
 #pragma warning( push )
 #pragma warning( disable : 26444 )
@@ -19,9 +26,9 @@ RTTR_REGISTRATION{
 		.constructor<const Vector3&, const Euler&, const Vector3&>()
 		.method("Initialize", &GameObject::Initialize)
 		.method("Destroy", &GameObject::Destroy)
-		.method("Update", &GameObject::Update)
 		.method("AddChild", &GameObject::AddChild)
 		.method("AddComponent", &GameObject::AddComponent)
+		.method("RemoveComponent", static_cast<void(GameObject::*)(Component*)>(&GameObject::RemoveComponent))
 		.method("RemoveChild", &GameObject::RemoveChild)
 		.method("RemoveAllChildren", &GameObject::RemoveAllChildren)
 		.method("AttachChild", &GameObject::AttachChild)
@@ -66,19 +73,27 @@ RTTR_REGISTRATION{
 		.method("Rotate", static_cast<void(GameObject::*)(float, float, float)>(&GameObject::Rotate))
 		.method("Rotate", static_cast<void(GameObject::*)(const Matrix3&)>(&GameObject::Rotate))
 		.method("Rotate", static_cast<void(GameObject::*)(const Quaternion&)>(&GameObject::Rotate))
-		.method("SetTag", &GameObject::SetTag)
-		.method("RemoveTag", &GameObject::RemoveTag)
-		.method("HasTag", &GameObject::HasTag);
+		.method("SetTag", static_cast<void(GameObject::*)(const std::string&)>(&GameObject::SetTag))
+		.method("RemoveTag", static_cast<void(GameObject::*)(const std::string&)>(&GameObject::RemoveTag))
+		.method("HasTag", static_cast<bool(GameObject::*)(const std::string&) const>(&GameObject::HasTag))
+		.method("GetHandle", &GameObject::GetHandle);
 		//TODO - Figure out how to handle template functions
+
+	rttr::registration::class_<GameObjectHandle>("GameObjectHandle")
+		.constructor()
+		.method("Get", &GameObjectHandle::Get)
+		.method("IsValid", &GameObjectHandle::IsValid);
 }
 #pragma warning( pop )
 
-GameObject::GameObject(const Vector3& position_, const Euler& rotation_, const Vector3& scale_) : transform(Transform(position_, rotation_, scale_)), components(std::vector<Component*>()), children(std::vector<GameObject*>()), tags(std::set<std::string>()), hasInitialized(false), isStatic(false){
+GameObject::GameObject(const Vector3& position_, const Euler& rotation_, const Vector3& scale_) : transform(Transform(position_, rotation_, scale_)), scene(nullptr), sceneIndex(Scene::notInScene), handleIndex(HandleTable<GameObject>::Add(this)), components(std::vector<Component*>()), scripts(std::vector<Script*>()), typeTable(), componentTypes(), children(std::vector<GameObject*>()), tags(std::vector<unsigned int>()), hasInitialized(false), isStatic(false){
 }
 
 GameObject::~GameObject(){
+	HandleTable<GameObject>::Remove(handleIndex);
+
 	#ifdef _DEBUG
-	if(!children.empty() || !components.empty() || !tags.empty() || !addComponentQueue.empty() || !removeComponentQueue.empty() || !createChildQueue.empty() || !removeChildQueue.empty()){
+	if(!children.empty() || !components.empty() || !tags.empty()){
 		Debug::LogWarning("Memory leak detected in GameObject!", __FILE__, __LINE__);
 		Destroy();
 	}
@@ -86,8 +101,6 @@ GameObject::~GameObject(){
 }
 
 bool GameObject::Initialize(){
-	Update();
-
 	if(hasInitialized){
 		Debug::LogWarning("You tried initializing an object that has already been initialized!", __FILE__, __LINE__);
 		return true;
@@ -112,6 +125,9 @@ bool GameObject::Initialize(){
 }
 
 void GameObject::Destroy(){
+	//Take everything out of the scene's registries first so that nothing can find a component that's being destroyed
+	SetScene(nullptr);
+
 	for(Component* component : components){
 		if(component != nullptr){
 			component->Destroy();
@@ -130,141 +146,84 @@ void GameObject::Destroy(){
 
 	components.clear();
 	components.shrink_to_fit();
+	scripts.clear();
+	scripts.shrink_to_fit();
+	typeTable.clear();
+	typeTable.shrink_to_fit();
+	componentTypes.reset();
 	children.clear();
 	children.shrink_to_fit();
 
 	tags.clear();
-
-	while(!addComponentQueue.empty()){
-		addComponentQueue.front()->Destroy();
-		delete addComponentQueue.front();
-		addComponentQueue.pop();
-	}
-
-	while(!removeComponentQueue.empty()){
-		//Everything in this queue has already been deleted by this point
-		removeComponentQueue.pop();
-	}
-
-	while(!createChildQueue.empty()){
-		createChildQueue.front()->Destroy();
-		delete createChildQueue.front();
-		createChildQueue.pop();
-	}
-
-	while(!removeChildQueue.empty()){
-		//Everything in this queue has already been deleted by this point
-		removeChildQueue.pop();
-	}
+	tags.shrink_to_fit();
 }
 
-bool GameObject::Update(){
-	while(!addComponentQueue.empty()){
-		Component* c = addComponentQueue.front();
-		addComponentQueue.pop();
-
-		components.push_back(c);
-
-		if(hasInitialized && c->Initialize(this) == false){
-			Debug::DisplayFatalErrorMessage("Component Error", "Component failed to initialize!");
-			return false;
-		}
-	}
-
-	while(!removeComponentQueue.empty()){
-		Component** c = removeComponentQueue.front();
-		removeComponentQueue.pop();
-
-		if((*c) != nullptr){
-			(*c)->Destroy();
-			delete (*c);
-			(*c) = nullptr;
-		}
-	}
-
-	//Remove all nullptrs from the component list
-	components.erase(std::remove(components.begin(), components.end(), nullptr), components.end());
-
-	while(!createChildQueue.empty()){
-		GameObject* go = createChildQueue.front();
-		createChildQueue.pop();
-
-		children.push_back(go);
-		go->GetTransform()->SetInitialParent(&transform);
-
-		if(hasInitialized && go->Initialize() == false){
-			Debug::DisplayFatalErrorMessage("GameObject Error", "Child GameObject failed to initialize!");
-			return false;
-		}
-	}
-
-	while(!removeChildQueue.empty()){
-		GameObject* go = removeChildQueue.front();
-		removeChildQueue.pop();
-
-		if(go != nullptr){
-			go->Destroy();
-			delete go;
-		}
-
-		children.erase(std::remove(children.begin(), children.end(), go), children.end());
-		go = nullptr;
-	}
-
-	while(!attachChildQueue.empty()){
-		GameObject* go = attachChildQueue.front();
-		attachChildQueue.pop();
-		SceneManager::CurrentScene()->DetachObject(go);
-		children.push_back(go);
-		go->GetTransform()->SetParent(&transform);
-	}
+void GameObject::AddChild(GameObject* child_){
+	_ASSERT(child_ != nullptr);
 
-	while(!detachChildQueue.empty()){
-		GameObject* go = detachChildQueue.front();
-		detachChildQueue.pop();
-		SceneManager::CurrentScene()->AttachObject(go);
-		go->GetTransform()->SetParent(nullptr);
-		children.erase(std::remove(children.begin(), children.end(), go), children.end());
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::AddChild, this, child_);
+	}else{
+		ApplyAddChild(child_);
 	}
-
-	for(GameObject* child : children){
-		if(child->hasInitialized){
-			child->Update();
-		}
-	}
-
-	return true;
 }
 
-void GameObject::AddChild(GameObject* child_){
-	_ASSERT(child_ != nullptr);
+void GameObject::AddComponent(Component* component_){
+	_ASSERT(component_ != nullptr);
 
-	createChildQueue.push(child_);
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::AddComponent, this, nullptr, component_);
+	}else{
+		ApplyAddComponent(component_);
+	}
 }
 
-void GameObject::AddComponent(Component* component_){
+void GameObject::RemoveComponent(Component* component_){
 	_ASSERT(component_ != nullptr);
 
-	addComponentQueue.push(component_);
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::RemoveComponent, this, nullptr, component_);
+	}else{
+		ApplyRemoveComponent(component_);
+	}
 }
 
 void GameObject::RemoveChild(GameObject* child_) {
 	_ASSERT(child_ != nullptr);
-	removeChildQueue.push(child_);
+
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::RemoveChild, this, child_);
+	}else{
+		ApplyRemoveChild(child_);
+	}
 }
 
 void GameObject::RemoveAllChildren(){
-	for(GameObject* go : children){
-		removeChildQueue.push(go);
+	//Copy the list, removal can happen immediately and would change it underneath us
+	const std::vector<GameObject*> childList = children;
+	for(GameObject* go : childList){
+		RemoveChild(go);
 	}
 }
 
 void GameObject::AttachChild(GameObject* child_){
-	attachChildQueue.push(child_);
+	_ASSERT(child_ != nullptr);
+
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::AttachChild, this, child_);
+	}else{
+		ApplyAttachChild(child_);
+	}
 }
 
 void GameObject::DetachChild(GameObject* child_){
-	detachChildQueue.push(child_);
+	_ASSERT(child_ != nullptr);
+
+	if(scene != nullptr){
+		scene->RecordCommand(SceneCommandType::DetachChild, this, child_);
+	}else{
+		ApplyDetachChild(child_);
+	}
 }
 
 Transform* GameObject::GetTransform(){
@@ -317,6 +276,14 @@ bool GameObject::IsStatic() const{
 	return isStatic;
 }
 
+Scene* GameObject::GetScene() const{
+	return scene;
+}
+
+GameObjectHandle GameObject::GetHandle() const{
+	return GameObjectHandle(handleIndex, HandleTable<GameObject>::Generation(handleIndex));
+}
+
 void GameObject::SetPosition(const Vector3& position_){
 	transform.SetPosition(position_);
 }
@@ -414,24 +381,224 @@ void GameObject::Rotate(const Quaternion& rotation_){
 }
 
 void GameObject::SetTag(const std::string& tag_){
-	tags.insert(tag_);
+	SetTag(TagTable::GetTag(tag_));
+}
+
+void GameObject::SetTag(unsigned int tag_){
+	if(HasTag(tag_)){
+		return;
+	}
+
+	tags.push_back(tag_);
+	if(scene != nullptr){
+		scene->RegisterTag(this, tag_);
+	}
 }
 
 void GameObject::SetStatic(bool static_){
 	isStatic = static_;
 }
 
+void GameObject::SetScene(Scene* scene_){
+	if(scene == scene_){
+		return;
+	}
+
+	for(Component* c : components){
+		if(c == nullptr){
+			continue;
+		}
+
+		if(scene != nullptr){
+			scene->UnregisterComponent(c);
+		}
+
+		if(scene_ != nullptr){
+			scene_->RegisterComponent(c);
+		}
+	}
+
+	for(unsigned int tag : tags){
+		if(scene != nullptr){
+			scene->UnregisterTag(this, tag);
+		}
+
+		if(scene_ != nullptr){
+			scene_->RegisterTag(this, tag);
+		}
+	}
+
+	scene = scene_;
+
+	for(GameObject* child : children){
+		child->SetScene(scene_);
+	}
+}
+
 void GameObject::RemoveTag(const std::string& tag_){
-	#ifdef _DEBUG
-	if(tags.find(tag_) == tags.end()){
+	unsigned int tag = 0;
+	if(!TagTable::FindTag(tag_, tag) || !HasTag(tag)){
+		#ifdef _DEBUG
 		Debug::LogWarning("Could not find tag: " + tag_ + "!", __FILE__, __LINE__);
+		#endif //_DEBUG
 		return;
 	}
-	#endif //_DEBUG
 
-	tags.erase(tag_);
+	RemoveTag(tag);
+}
+
+void GameObject::RemoveTag(unsigned int tag_){
+	tags.erase(std::remove(tags.begin(), tags.end(), tag_), tags.end());
+	if(scene != nullptr){
+		scene->UnregisterTag(this, tag_);
+	}
 }
 
 bool GameObject::HasTag(const std::string& tag_) const{
-	return (tags.find(tag_) != tags.end());
+	unsigned int tag = 0;
+	return TagTable::FindTag(tag_, tag) && HasTag(tag);
+}
+
+bool GameObject::HasTag(unsigned int tag_) const{
+	return (std::find(tags.begin(), tags.end(), tag_) != tags.end());
+}
+
+bool GameObject::ApplyAddComponent(Component* component_){
+	_ASSERT(component_ != nullptr);
+
+	components.push_back(component_);
+
+	//File the component under every type it is, so that lookups are a single index
+	const ComponentTypeID::Mask& mask = ComponentTypeID::MaskOf(component_);
+	const unsigned int typeCount = std::min(ComponentTypeID::Count(), ComponentTypeID::maxTypes);
+	if(typeTable.size() < typeCount){
+		typeTable.resize(typeCount);
+	}
+
+	for(unsigned int i = 0; i < typeCount; i++){
+		if(mask.test(i)){
+			typeTable[i].push_back(component_);
+		}
+	}
+
+	componentTypes |= mask;
+
+	if(scene != nullptr){
+		scene->RegisterComponent(component_);
+	}
+
+	if(mask.test(ComponentTypeID::Get<Script>())){
+		scripts.push_back(static_cast<Script*>(component_));
+	}
+
+	if(hasInitialized && component_->Initialize(this) == false){
+		Debug::DisplayFatalErrorMessage("Component Error", "Component failed to initialize!");
+		return false;
+	}
+
+	return true;
+}
+
+void GameObject::ApplyRemoveComponent(Component* component_){
+	_ASSERT(component_ != nullptr);
+
+	//The same component can be asked to be removed more than once in a frame
+	if(std::find(components.begin(), components.end(), component_) == components.end()){
+		return;
+	}
+
+	const ComponentTypeID::Mask& mask = ComponentTypeID::MaskOf(component_);
+	if(mask.test(ComponentTypeID::Get<Script>())){
+		scripts.erase(std::remove(scripts.begin(), scripts.end(), static_cast<Script*>(component_)), scripts.end());
+	}
+
+	component_->Destroy();
+	if(scene != nullptr){
+		scene->UnregisterComponent(component_);
+	}
+
+	components.erase(std::remove(components.begin(), components.end(), component_), components.end());
+	for(unsigned int i = 0; i < typeTable.size(); i++){
+		if(mask.test(i)){
+			typeTable[i].erase(std::remove(typeTable[i].begin(), typeTable[i].end(), component_), typeTable[i].end());
+			componentTypes.set(i, !typeTable[i].empty());
+		}
+	}
+
+	delete component_;
+}
+
+bool GameObject::ApplyAddChild(GameObject* child_){
+	_ASSERT(child_ != nullptr);
+
+	children.push_back(child_);
+	child_->GetTransform()->SetInitialParent(&transform);
+	child_->SetScene(scene);
+
+	if(hasInitialized && child_->Initialize() == false){
+		Debug::DisplayFatalErrorMessage("GameObject Error", "Child GameObject failed to initialize!");
+		return false;
+	}
+
+	return true;
+}
+
+bool GameObject::ApplyAddChildren(const std::vector<GameObject*>& children_){
+	children.reserve(children.size() + children_.size());
+
+	//Parent everything first so the whole batch is in place before any of it initializes
+	for(GameObject* child : children_){
+		_ASSERT(child != nullptr);
+		children.push_back(child);
+		child->GetTransform()->SetInitialParent(&transform);
+		child->SetScene(scene);
+	}
+
+	if(!hasInitialized){
+		return true;
+	}
+
+	for(GameObject* child : children_){
+		if(child->Initialize() == false){
+			Debug::DisplayFatalErrorMessage("GameObject Error", "Child GameObject failed to initialize!");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GameObject::ApplyRemoveChild(GameObject* child_){
+	_ASSERT(child_ != nullptr);
+
+	if(std::find(children.begin(), children.end(), child_) == children.end()){
+		return;
+	}
+
+	children.erase(std::remove(children.begin(), children.end(), child_), children.end());
+	child_->Destroy();
+	delete child_;
+}
+
+void GameObject::ApplyAttachChild(GameObject* child_){
+	_ASSERT(child_ != nullptr);
+
+	//A child can't also be at the top level of its scene
+	if(child_->scene != nullptr){
+		child_->scene->DetachObject(child_);
+	}
+
+	children.push_back(child_);
+	child_->GetTransform()->SetParent(&transform);
+	child_->SetScene(scene);
+}
+
+void GameObject::ApplyDetachChild(GameObject* child_){
+	_ASSERT(child_ != nullptr);
+
+	//Detached children go back to the top level of the scene
+	Scene* targetScene = (scene != nullptr) ? scene : SceneManager::CurrentScene();
+	targetScene->AttachObject(child_);
+	child_->GetTransform()->SetParent(nullptr);
+	children.erase(std::remove(children.begin(), children.end(), child_), children.end());
 }
\ No newline at end of file
@@ -1,26 +1,37 @@
 #ifndef GAME_OBJECT_H
 #define GAME_OBJECT_H
 
-#include <queue>
-#include <set>
 #include <vector>
 
 #include "Component.h"
+#include "Handle.h"
+#include "ObjectPool.h"
 #include "Transform.h"
 
 namespace PizzaBox{
+	class GameObject;
+	class Scene;
+	class Script;
+
+	using GameObjectHandle = Handle<GameObject>;
+
 	class GameObject{
 	public:
 		GameObject(const Vector3& position_ = PizzaBox::Vector3(), const Euler& rotation_ = PizzaBox::Euler(), const Vector3& scale_ = PizzaBox::Vector3(1.0f, 1.0f, 1.0f));
 		virtual ~GameObject();
 
+		//GameObjects are allocated from the ObjectPool, the virtual destructor makes sure the right size comes back here for derived types
+		static void* operator new(size_t size_){ return ObjectPool::Allocate(size_); }
+		static void operator delete(void* block_, size_t size_){ ObjectPool::Free(block_, size_); }
+
 		bool Initialize();
 		void Destroy();
 
-		bool Update();
-
+		//Structural changes are recorded by the object's Scene and applied by Scene::Update at the end of the frame
+		//Objects that aren't in a scene yet have their changes applied straight away
 		void AddChild(GameObject* child_);
 		void AddComponent(Component* component_);
+		void RemoveComponent(Component* component_);
 		void RemoveChild(GameObject* child_);
 		void RemoveAllChildren();
 		void AttachChild(GameObject* child_);
@@ -39,6 +50,8 @@ namespace PizzaBox{
 		Vector3 GetScale() const;
 		Vector3 GlobalScale() const;
 		bool IsStatic() const;
+		Scene* GetScene() const;
+		GameObjectHandle GetHandle() const;
 
 		inline Vector3 GetForward() const{ return transform.GetForward(); }
 		inline Vector3 GetUp() const{ return transform.GetUp(); }
@@ -54,6 +67,8 @@ namespace PizzaBox{
 		void SetScale(float x_, float y_, float z_);
 		void SetScale(float s_);
 		void SetStatic(bool static_);
+		//Moves this object's components, and those of its children, into the given scene's registries
+		void SetScene(Scene* scene_);
 
 		void SetGlobalPosition(const Vector3& position_);
 		void SetGlobalPosition(const float x, const float y, const float z);
@@ -73,38 +88,40 @@ namespace PizzaBox{
 		void Rotate(const Quaternion& rotation_);
 
 		void SetTag(const std::string& tag_);
+		void SetTag(unsigned int tag_);
 		void RemoveTag(const std::string& tag_);
+		void RemoveTag(unsigned int tag_);
 		bool HasTag(const std::string& tag_) const;
+		bool HasTag(unsigned int tag_) const;
+
+		//Scripts are cached separately so that event delivery doesn't have to search every component
+		inline const std::vector<Script*>& GetScripts() const{ return scripts; }
+		inline const std::vector<GameObject*>& GetChildren() const{ return children; }
+		inline const std::vector<unsigned int>& GetTags() const{ return tags; }
+
+		template <class T> bool HasComponent() const{
+			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
+			const unsigned int id = ComponentTypeID::Get<T>();
+			return id < ComponentTypeID::maxTypes && componentTypes.test(id);
+		}
 
 		template <class T> T* GetComponent(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			T* comp = nullptr;
+			const std::vector<Component*>& compList = ComponentsOfType<T>();
 
-			//Check every component on this object
-			for(Component* c : components){
-				//Cast this Component* to a T* (whatever type of component you're looking for)
-				comp = dynamic_cast<T*>(c);
-				//If the cast was successful (did not return nullptr), then we have that type of component, so return it
-				if(comp != nullptr){
-					return comp;
-				}
+			//If no component of this type was found, return nullptr
+			if(compList.empty()){
+				return nullptr;
 			}
 
-			//If no component of this type was found, return nullptr
-			return nullptr;
+			//Everything in the list is known to be a T from its type mask, so a static_cast is enough here
+			return static_cast<T*>(compList.front());
 		}
 
 		template <class T> std::vector<T*> GetComponents(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
 			std::vector<T*> compList = std::vector<T*>();
-
-			for(Component* c : components){
-				T* comp = dynamic_cast<T*>(c);
-				if(comp != nullptr){
-					compList.push_back(comp);
-				}
-			}
-
+			AppendComponents<T>(compList);
 			return compList;
 		}
 
@@ -133,78 +150,91 @@ namespace PizzaBox{
 
 		template <class T> std::vector<T*> GetComponentsInChildren(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			std::vector<T*> tmpList = std::vector<T*>();
 			std::vector<T*> compList = std::vector<T*>();
-
-			//Check all children of this object
-			for(GameObject* go : children){
-				//Add all the T*'s this child has to the list
-				tmpList = go->GetComponents<T>();
-				for(T* comp : tmpList){
-					compList.push_back(comp);
-				}
-
-				//Get all the components from the children of this object and add them to the list
-				std::vector<T*> c = go->GetComponentsInChildren<T>();
-				for(T* t : c){
-					compList.push_back(t);
-				}
-			}
-
+			AppendComponentsInChildren<T>(compList);
 			return compList;
 		}
 
 		template <class T> std::vector<T*> GetComponentsInFamily(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			//Get the list of any T*'s that the parent has
-			std::vector<T*> compList = GetComponents<T>();
-
-			//Get all the components on all child objects
-			std::vector<T*> chList = GetComponentsInChildren<T>();
-			for(T* t : chList){
-				compList.push_back(t);
-			}
-
+			std::vector<T*> compList = std::vector<T*>();
+			//Get the list of any T*'s that the parent has, then all the ones on child objects
+			AppendComponents<T>(compList);
+			AppendComponentsInChildren<T>(compList);
 			return compList;
 		}
 
 		template <class T> void RemoveComponent(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			T* comp = nullptr;
-
-			for(unsigned int i = 0; i < components.size(); i++){
-				comp = dynamic_cast<T*>(components[i]);
-				if(comp != nullptr){
-					removeComponentQueue.push(&components[i]);
-				}
+			T* comp = GetComponent<T>();
+			if(comp != nullptr){
+				RemoveComponent(comp);
 			}
 		}
 
 		template <class T> void RemoveComponents(){
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			for(unsigned int i = 0; i < components.size(); i++){
-				T* comp = dynamic_cast<T*>(components[i]);
-				if(comp != nullptr){
-					removeComponentQueue.push(&components[i]);
-				}
+			//Copy the list, removal can happen immediately and would change it underneath us
+			const std::vector<Component*> compList = ComponentsOfType<T>();
+			for(Component* c : compList){
+				RemoveComponent(c);
 			}
 		}
 
 	protected:
+		//This allows the Scene to apply commands recorded for this object
+		friend class Scene;
+
 		Transform transform;
+		Scene* scene; //The scene whose component registries this object's components are in
+		size_t sceneIndex; //Where this object is in its scene's list of top level objects, so it can be swapped out in constant time
+		unsigned int handleIndex;
 		std::vector<GameObject*> children;
 		std::vector<Component*> components;
+		std::vector<Script*> scripts;
+		//Components of each type (including base types like Script), indexed by ComponentTypeID and kept up to date as components come and go
+		std::vector<std::vector<Component*>> typeTable;
+		ComponentTypeID::Mask componentTypes; //Which types this object has at least one of
 		bool hasInitialized;
 		bool isStatic;
 
-		std::set<std::string> tags;
+		std::vector<unsigned int> tags; //IDs from the TagTable, objects rarely have more than a couple so a flat list is fastest
 
-		std::queue<Component*> addComponentQueue;
-		std::queue<Component**> removeComponentQueue;
-		std::queue<GameObject*> createChildQueue;
-		std::queue<GameObject*> removeChildQueue;
-		std::queue<GameObject*> attachChildQueue;
-		std::queue<GameObject*> detachChildQueue;
+		//These carry out the changes the public functions ask for, either right away or when the Scene applies its commands
+		bool ApplyAddComponent(Component* component_);
+		void ApplyRemoveComponent(Component* component_);
+		bool ApplyAddChild(GameObject* child_);
+		bool ApplyAddChildren(const std::vector<GameObject*>& children_);
+		void ApplyRemoveChild(GameObject* child_);
+		void ApplyAttachChild(GameObject* child_);
+		void ApplyDetachChild(GameObject* child_);
+
+		static const std::vector<Component*> noComponents;
+
+		template <class T> const std::vector<Component*>& ComponentsOfType() const{
+			const unsigned int id = ComponentTypeID::Get<T>();
+			if(id >= ComponentTypeID::maxTypes || !componentTypes.test(id)){
+				return noComponents;
+			}
+
+			return typeTable[id];
+		}
+
+		template <class T> void AppendComponents(std::vector<T*>& compList_){
+			const std::vector<Component*>& typeList = ComponentsOfType<T>();
+			compList_.reserve(compList_.size() + typeList.size());
+			for(Component* c : typeList){
+				compList_.push_back(static_cast<T*>(c));
+			}
+		}
+
+		template <class T> void AppendComponentsInChildren(std::vector<T*>& compList_){
+			//Add all the T*'s each child has to the list, followed by the ones on that child's children
+			for(GameObject* go : children){
+				go->AppendComponents<T>(compList_);
+				go->AppendComponentsInChildren<T>(compList_);
+			}
+		}
 	};
 }
 
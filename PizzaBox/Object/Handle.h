@@ -0,0 +1,106 @@
+#ifndef HANDLE_H
+#define HANDLE_H
+
+#include <vector>
+
+namespace PizzaBox{
+	//Keeps track of every live object of one type, bumping a slot's generation whenever its object is destroyed
+	template <class T> class HandleTable{
+	public:
+		static constexpr unsigned int invalidIndex = 0xFFFFFFFF;
+
+		static unsigned int Add(T* object_){
+			_ASSERT(object_ != nullptr);
+
+			unsigned int index = invalidIndex;
+			if(!freeSlots.empty()){
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}else{
+				index = static_cast<unsigned int>(slots.size());
+				slots.push_back(Slot());
+			}
+
+			slots[index].object = object_;
+			return index;
+		}
+
+		static void Remove(unsigned int index_){
+			_ASSERT(index_ < slots.size());
+
+			//Any handle still holding the old generation will now come back empty
+			slots[index_].object = nullptr;
+			slots[index_].generation++;
+			freeSlots.push_back(index_);
+		}
+
+		static T* Get(unsigned int index_, unsigned int generation_){
+			if(index_ >= slots.size() || slots[index_].generation != generation_){
+				return nullptr;
+			}
+
+			return slots[index_].object;
+		}
+
+		static unsigned int Generation(unsigned int index_){
+			_ASSERT(index_ < slots.size());
+			return slots[index_].generation;
+		}
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		HandleTable() = delete;
+		HandleTable(const HandleTable&) = delete;
+		HandleTable(HandleTable&&) = delete;
+		HandleTable& operator=(const HandleTable&) = delete;
+		HandleTable& operator=(HandleTable&&) = delete;
+		~HandleTable() = delete;
+
+	private:
+		struct Slot{
+			Slot() : object(nullptr), generation(0){}
+
+			T* object;
+			unsigned int generation;
+		};
+
+		static std::vector<Slot> slots;
+		static std::vector<unsigned int> freeSlots;
+	};
+
+	template <class T> constexpr unsigned int HandleTable<T>::invalidIndex;
+	template <class T> std::vector<typename HandleTable<T>::Slot> HandleTable<T>::slots;
+	template <class T> std::vector<unsigned int> HandleTable<T>::freeSlots;
+
+	//A reference to an object that can safely outlive it, Get returns nullptr once the object has been destroyed
+	template <class T> class Handle{
+	public:
+		Handle() : index(HandleTable<T>::invalidIndex), generation(0){}
+		Handle(unsigned int index_, unsigned int generation_) : index(index_), generation(generation_){}
+
+		T* Get() const{
+			return HandleTable<T>::Get(index, generation);
+		}
+
+		template <class U> U* GetAs() const{
+			return dynamic_cast<U*>(Get());
+		}
+
+		bool IsValid() const{
+			return Get() != nullptr;
+		}
+
+		bool operator==(const Handle& other_) const{
+			return index == other_.index && generation == other_.generation;
+		}
+
+		bool operator!=(const Handle& other_) const{
+			return !(*this == other_);
+		}
+
+	private:
+		unsigned int index;
+		unsigned int generation;
+	};
+}
+
+#endif //!HANDLE_H
\ No newline at end of file
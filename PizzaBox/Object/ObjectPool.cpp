@@ -0,0 +1,102 @@
+#include "ObjectPool.h"
+
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+//Initialize static variables here
+constexpr size_t ObjectPool::granularity;
+constexpr size_t ObjectPool::maxPooledSize;
+constexpr size_t ObjectPool::blocksPerChunk;
+std::vector<ObjectPool::SizeClass> ObjectPool::sizeClasses = std::vector<ObjectPool::SizeClass>(ObjectPool::maxPooledSize / ObjectPool::granularity);
+
+void* ObjectPool::Allocate(size_t size_){
+	if(size_ == 0 || size_ > maxPooledSize){
+		return ::operator new(size_);
+	}
+
+	const size_t index = SizeClassIndex(size_);
+	SizeClass& sizeClass = sizeClasses[index];
+	if(sizeClass.freeList == nullptr){
+		AddChunk(sizeClass, (index + 1) * granularity, blocksPerChunk);
+	}
+
+	FreeBlock* block = sizeClass.freeList;
+	sizeClass.freeList = block->next;
+	sizeClass.blocksInUse++;
+	return block;
+}
+
+void ObjectPool::Free(void* block_, size_t size_){
+	if(block_ == nullptr){
+		return;
+	}
+
+	if(size_ == 0 || size_ > maxPooledSize){
+		::operator delete(block_);
+		return;
+	}
+
+	SizeClass& sizeClass = sizeClasses[SizeClassIndex(size_)];
+	_ASSERT(sizeClass.blocksInUse > 0);
+
+	FreeBlock* block = static_cast<FreeBlock*>(block_);
+	block->next = sizeClass.freeList;
+	sizeClass.freeList = block;
+	sizeClass.blocksInUse--;
+}
+
+void ObjectPool::Reserve(size_t size_, size_t count_){
+	if(size_ == 0 || size_ > maxPooledSize){
+		return;
+	}
+
+	const size_t index = SizeClassIndex(size_);
+	SizeClass& sizeClass = sizeClasses[index];
+
+	//One chunk big enough for everything that's missing, rather than lots of small ones
+	const size_t freeBlocks = sizeClass.totalBlocks - sizeClass.blocksInUse;
+	if(freeBlocks < count_){
+		AddChunk(sizeClass, (index + 1) * granularity, count_ - freeBlocks);
+	}
+}
+
+size_t ObjectPool::BlocksInUse(){
+	size_t total = 0;
+	for(const SizeClass& sizeClass : sizeClasses){
+		total += sizeClass.blocksInUse;
+	}
+
+	return total;
+}
+
+size_t ObjectPool::ReservedBytes(){
+	size_t total = 0;
+	for(size_t i = 0; i < sizeClasses.size(); i++){
+		total += sizeClasses[i].totalBlocks * (i + 1) * granularity;
+	}
+
+	return total;
+}
+
+size_t ObjectPool::SizeClassIndex(size_t size_){
+	_ASSERT(size_ > 0 && size_ <= maxPooledSize);
+	return (size_ + granularity - 1) / granularity - 1;
+}
+
+void ObjectPool::AddChunk(SizeClass& sizeClass_, size_t blockSize_, size_t blockCount_){
+	_ASSERT(blockSize_ >= sizeof(FreeBlock));
+	_ASSERT(blockCount_ > 0);
+
+	//new[] gives back memory aligned for any fundamental type, and every block size is a multiple of that alignment
+	sizeClass_.chunks.push_back(std::unique_ptr<char[]>(new char[blockSize_ * blockCount_]));
+	sizeClass_.totalBlocks += blockCount_;
+	char* chunk = sizeClass_.chunks.back().get();
+
+	//Thread the new blocks onto the free list, first block first
+	for(size_t i = blockCount_; i > 0; i--){
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize_);
+		block->next = sizeClass_.freeList;
+		sizeClass_.freeList = block;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <memory>
+#include <vector>
+
+namespace PizzaBox{
+	//Hands out fixed size blocks carved from larger chunks, so spawning and destroying lots of objects doesn't fragment the heap
+	//GameObjects and Components route their operator new and delete through here, which means every derived type is pooled as well
+	//This is only meant to be used from the main thread
+	class ObjectPool{
+	public:
+		static void* Allocate(size_t size_);
+		static void Free(void* block_, size_t size_);
+		//Makes sure at least count_ blocks of this size can be handed out without allocating again
+		static void Reserve(size_t size_, size_t count_);
+
+		static size_t BlocksInUse();
+		static size_t ReservedBytes();
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		ObjectPool() = delete;
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool(ObjectPool&&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+		ObjectPool& operator=(ObjectPool&&) = delete;
+		~ObjectPool() = delete;
+
+	private:
+		static constexpr size_t granularity = 16; //Block sizes are rounded up to this, which also keeps every block aligned
+		static constexpr size_t maxPooledSize = 1024; //Anything bigger than this just goes to the regular heap
+		static constexpr size_t blocksPerChunk = 64;
+
+		struct FreeBlock{
+			FreeBlock* next;
+		};
+
+		struct SizeClass{
+			SizeClass() : freeList(nullptr), chunks(), blocksInUse(0), totalBlocks(0){}
+
+			FreeBlock* freeList;
+			std::vector<std::unique_ptr<char[]>> chunks;
+			size_t blocksInUse;
+			size_t totalBlocks;
+		};
+
+		static std::vector<SizeClass> sizeClasses;
+
+		static size_t SizeClassIndex(size_t size_);
+		static void AddChunk(SizeClass& sizeClass_, size_t blockSize_, size_t blockCount_);
+	};
+}
+
+#endif //!OBJECT_POOL_H
\ No newline at end of file
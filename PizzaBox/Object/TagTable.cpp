@@ -0,0 +1,51 @@
+#include "TagTable.h"
+
+#include <rttr/registration.h>
+
+using namespace PizzaBox;
+
+//Initialize static variables here
+std::unordered_map<std::string, unsigned int> TagTable::tagIDs;
+std::vector<std::string> TagTable::tagNames;
+
+//Suppress meaningless and unavoidable warning
+#pragma warning( push )
+#pragma warning( disable : 26444 )
+RTTR_REGISTRATION{
+	rttr::registration::class_<TagTable>("TagTable")
+		.method("GetTag", &TagTable::GetTag)
+		.method("GetTagName", &TagTable::GetTagName)
+		.method("TagCount", &TagTable::TagCount);
+}
+#pragma warning( pop )
+
+unsigned int TagTable::GetTag(const std::string& tagName_){
+	const auto tag = tagIDs.find(tagName_);
+	if(tag != tagIDs.end()){
+		return tag->second;
+	}
+
+	const unsigned int newTag = static_cast<unsigned int>(tagNames.size());
+	tagIDs[tagName_] = newTag;
+	tagNames.push_back(tagName_);
+	return newTag;
+}
+
+bool TagTable::FindTag(const std::string& tagName_, unsigned int& tag_){
+	const auto tag = tagIDs.find(tagName_);
+	if(tag == tagIDs.end()){
+		return false;
+	}
+
+	tag_ = tag->second;
+	return true;
+}
+
+const std::string& TagTable::GetTagName(unsigned int tag_){
+	_ASSERT(tag_ < tagNames.size());
+	return tagNames[tag_];
+}
+
+unsigned int TagTable::TagCount(){
+	return static_cast<unsigned int>(tagNames.size());
+}
\ No newline at end of file
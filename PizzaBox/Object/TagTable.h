@@ -0,0 +1,33 @@
+#ifndef TAG_TABLE_H
+#define TAG_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PizzaBox{
+	//Turns tag names into small integer IDs so that objects and scenes can store and compare tags without touching strings
+	class TagTable{
+	public:
+		//Returns the ID for this tag, adding it to the table if it's new
+		static unsigned int GetTag(const std::string& tagName_);
+		//Like GetTag, but returns false instead of adding tags that nothing has used yet
+		static bool FindTag(const std::string& tagName_, unsigned int& tag_);
+		static const std::string& GetTagName(unsigned int tag_);
+		static unsigned int TagCount();
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		TagTable() = delete;
+		TagTable(const TagTable&) = delete;
+		TagTable(TagTable&&) = delete;
+		TagTable& operator=(const TagTable&) = delete;
+		TagTable& operator=(TagTable&&) = delete;
+		~TagTable() = delete;
+
+	private:
+		static std::unordered_map<std::string, unsigned int> tagIDs;
+		static std::vector<std::string> tagNames;
+	};
+}
+
+#endif //!TAG_TABLE_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Collider.h"
 
 #include "AABB.h"
+#include "CollisionLayers.h"
 #include "Rigidbody.h"
 #include "PhysicsEngine.h"
 #include "Script/Script.h"
@@ -8,7 +9,7 @@
 
 using namespace PizzaBox;
 
-Collider::Collider(const Vector3& scale_, const Vector3& offset_, bool isTrigger_) : Component(), scale(scale_), isTrigger(isTrigger_), offset(offset_), externalBody(nullptr){
+Collider::Collider(const Vector3& scale_, const Vector3& offset_, bool isTrigger_) : Component(), scale(scale_), isTrigger(isTrigger_), offset(offset_), externalBody(nullptr), triggerShape(nullptr), layer(CollisionLayers::defaultLayer){
 }
 
 Collider::~Collider(){
@@ -31,10 +32,24 @@ bool Collider::Initialize(GameObject* go_){
 		externalBody->addCollisionShape(new rp3d::BoxShape(rp3d::Vector3(scale.x / 2.0f, scale.y / 2.0f, scale.z / 2.0f)), rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), 0.0f);
 	}
 
+	ApplyLayer();
+
 	return true;
 }
 
 void Collider::Destroy(){
+	//Copies held by prefabs were never registered
+	if(gameObject == nullptr){
+		return;
+	}
+
+	if(externalBody == nullptr){
+		//Triggers never get a body
+		PhysicsEngine::UnregisterCollider(this);
+		gameObject = nullptr;
+		return;
+	}
+
 	std::vector<rp3d::ProxyShape*> shapes;
 	auto proxShape = externalBody->getProxyShapesList();
 	while(proxShape != nullptr){
@@ -50,6 +65,14 @@ void Collider::Destroy(){
 	gameObject = nullptr;
 }
 
+Component* Collider::Clone() const{
+	//The body and its box shape are made when the copy is initialized
+	Collider* clone = new Collider(scale, offset, isTrigger);
+	clone->SetEnable(GetEnable());
+	clone->layer = layer;
+	return clone;
+}
+
 void Collider::PreUpdate(){
 	if(externalBody == nullptr){
 		return;
@@ -58,6 +81,29 @@ void Collider::PreUpdate(){
 	externalBody->setTransform(PhysicsEngine::SetupTransform(gameObject));
 }
 
+void Collider::SetLayer(const std::string& layerName_){
+	const int newLayer = CollisionLayers::GetLayer(layerName_);
+	if(newLayer < 0){
+		Debug::LogWarning("Unknown collision layer " + layerName_ + "!", __FILE__, __LINE__);
+		return;
+	}
+
+	layer = newLayer;
+	ApplyLayer();
+}
+
+void Collider::ApplyLayer(){
+	//Triggers have no body, PhysicsEngine reads their layer directly
+	if(externalBody == nullptr){
+		return;
+	}
+
+	for(rp3d::ProxyShape* ps = externalBody->getProxyShapesList(); ps != nullptr; ps = ps->getNext()){
+		ps->setCollisionCategoryBits(CollisionLayers::CategoryBits(layer));
+		ps->setCollideWithMaskBits(CollisionLayers::CollideWithBits(layer));
+	}
+}
+
 bool Collider::CheckCollision(const Collider* const c1_, const Collider* const c2_){
 	Vector3 c1Pos = c1_->gameObject->GlobalPosition() + c1_->offset;
 	Vector3 c2Pos = c2_->gameObject->GlobalPosition() + c2_->offset;
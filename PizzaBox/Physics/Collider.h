@@ -14,9 +14,13 @@ namespace PizzaBox{
 
 		bool Initialize(GameObject* go_) override;
 		void Destroy() override;
+		Component* Clone() const override;
 		
 		void PreUpdate();
 
+		int GetLayer() const{ return layer; }
+		void SetLayer(const std::string& layerName_);
+
 		static bool CheckCollision(const Collider* const c1_, const Collider* const c2_);
 
 	private:
@@ -26,6 +30,10 @@ namespace PizzaBox{
 		bool isTrigger;
 		Vector3 offset;
 		rp3d::RigidBody* externalBody;
+		rp3d::CollisionShape* triggerShape; //Only triggers have one, it's never added to a body and only used to find the trigger's bounds
+		int layer;
+
+		void ApplyLayer();
 	};
 }
 
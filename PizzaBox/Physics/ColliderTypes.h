@@ -21,44 +21,58 @@ namespace PizzaBox{
 		BaseCollider(Shape shape_) : shape(shape_){}
 		virtual ~BaseCollider(){}
 
+		virtual BaseCollider* Clone() const = 0;
+
 		Shape shape;
 	};
 
 	struct BoxCollider : public BaseCollider{
 		BoxCollider(const Vector3& scale_) : BaseCollider(Shape::Box), scale(scale_){}
 
+		virtual BaseCollider* Clone() const override{ return new BoxCollider(*this); }
+
 		Vector3 scale;
 	};
 
 	struct SphereCollider : public BaseCollider{
 		SphereCollider(float radius_) : BaseCollider(Shape::Sphere), radius(radius_){}
 
+		virtual BaseCollider* Clone() const override{ return new SphereCollider(*this); }
+
 		float radius;
 	};
 
 	struct CapsuleCollider : public BaseCollider{
 		CapsuleCollider(float radius_, float height_) : BaseCollider(Shape::Capsule), radius(radius_), height(height_){}
 
+		virtual BaseCollider* Clone() const override{ return new CapsuleCollider(*this); }
+
 		float radius;
 		float height;
 	};
 
+	//Mesh colliders share their cooked shape with every other collider using the same model and scale
 	struct ConvexCollider : public BaseCollider{
-		ConvexCollider(const std::string& modelName_);
+		ConvexCollider(const std::string& modelName_, const Vector3& scale_ = Vector3::Fill(1.0f));
+		//Copies share the cached shape and hold a reference of their own
+		ConvexCollider(const ConvexCollider& other_);
+		ConvexCollider& operator=(const ConvexCollider&) = delete;
 		~ConvexCollider();
 
+		virtual BaseCollider* Clone() const override{ return new ConvexCollider(*this); }
+
 		rp3d::ConvexMeshShape* shape;
 	};
 
 	struct ConcaveCollider : public BaseCollider{
-		ConcaveCollider(const std::string& modelName_);
+		ConcaveCollider(const std::string& modelName_, const Vector3& scale_ = Vector3::Fill(1.0f));
+		ConcaveCollider(const ConcaveCollider& other_);
+		ConcaveCollider& operator=(const ConcaveCollider&) = delete;
 		~ConcaveCollider();
 
-		std::vector<float> vertices;
-		std::vector<int> indices;
-		rp3d::TriangleVertexArray* triangleArray;
-		rp3d::TriangleMesh* mesh;
-		rp3d::ConcaveShape* shape;
+		virtual BaseCollider* Clone() const override{ return new ConcaveCollider(*this); }
+
+		rp3d::ConcaveMeshShape* shape;
 	};
 }
 
@@ -0,0 +1,243 @@
+#include "CollisionLayers.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+
+#include <rttr/registration.h>
+
+#include "Core/FileSystem.h"
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+//Initialize static variables here
+constexpr int CollisionLayers::maxLayers;
+constexpr int CollisionLayers::defaultLayer;
+const std::string CollisionLayers::layerFile = "CollisionLayers.ini";
+std::vector<CollisionLayers::LayerInfo> CollisionLayers::layers;
+std::map<std::string, int> CollisionLayers::layerIndices;
+
+//Suppress meaningless and unavoidable warning
+#pragma warning( push )
+#pragma warning( disable : 26444 )
+RTTR_REGISTRATION{
+	rttr::registration::class_<CollisionLayers>("CollisionLayers")
+		.method("GetLayer", &CollisionLayers::GetLayer)
+		.method("GetLayerName", &CollisionLayers::GetLayerName)
+		.method("CategoryBits", &CollisionLayers::CategoryBits)
+		.method("CollideWithBits", &CollisionLayers::CollideWithBits)
+		.method("EventsEnabled", &CollisionLayers::EventsEnabled)
+		.method("LayerMask", &CollisionLayers::LayerMask);
+}
+#pragma warning( pop )
+
+bool CollisionLayers::Initialize(){
+	SetDefaultLayers();
+
+	if(!FileSystem::FileExists(layerFile)){
+		WriteDefaultFile();
+		return true;
+	}
+
+	//Each layer gets its own section:
+	//[LayerName]
+	//Bit=1
+	//CollidesWith=Default,Player (or All, or None)
+	//Events=1
+	//Naming another layer lets the two collide both ways, All only covers layers that haven't opted out with None
+	std::map<std::string, std::map<std::string, std::string>> records;
+	FileSystem::ReadRecords(layerFile, records);
+
+	//The file is edited by hand, so anything wrong with it is skipped with a warning instead of stopping the engine
+	std::vector<std::string> assignedBits = std::vector<std::string>(maxLayers);
+	for(const auto& section : records){
+		const auto bit = section.second.find("Bit");
+		if(bit == section.second.end()){
+			Debug::LogWarning("Collision layer " + section.first + " has no Bit!", __FILE__, __LINE__);
+			continue;
+		}
+
+		int index = -1;
+		if(!ParseInt(bit->second, index) || index < 0 || index >= maxLayers){
+			Debug::LogWarning("Collision layer " + section.first + " must use a Bit from 0 to " + std::to_string(maxLayers - 1) + "!", __FILE__, __LINE__);
+			continue;
+		}
+
+		if(!assignedBits[index].empty()){
+			Debug::LogWarning("Collision layers " + assignedBits[index] + " and " + section.first + " both use Bit " + std::to_string(index) + ", " + section.first + " will be ignored!", __FILE__, __LINE__);
+			continue;
+		}
+
+		assignedBits[index] = section.first;
+		const std::string name = ToLower(Trim(section.first));
+
+		layerIndices.erase(layers[index].name);
+		layers[index].name = name;
+		layers[index].isUsed = true;
+		layers[index].collideWith = 0;
+		layerIndices[name] = index;
+
+		const auto events = section.second.find("Events");
+		int eventsValue = 0;
+		if(events != section.second.end()){
+			if(ParseInt(events->second, eventsValue)){
+				layers[index].events = (eventsValue != 0);
+			}else{
+				Debug::LogWarning("Collision layer " + section.first + " has an invalid Events value, it should be 0 or 1!", __FILE__, __LINE__);
+			}
+		}
+	}
+
+	//Work out the matrix once every layer has a bit
+	for(const auto& section : records){
+		const int index = GetLayer(Trim(section.first));
+		const auto collidesWith = section.second.find("CollidesWith");
+		//Layers that were skipped above, including the second of two sharing a bit, don't get a say in the matrix
+		if(index < 0 || collidesWith == section.second.end() || assignedBits[index] != section.first){
+			continue;
+		}
+
+		std::stringstream list(collidesWith->second);
+		std::string entry;
+		while(std::getline(list, entry, ',')){
+			const std::string other = ToLower(Trim(entry));
+			if(other.empty() || other == "none"){
+				continue;
+			}else if(other == "all"){
+				layers[index].collideWith = 0xFFFF;
+				continue;
+			}
+
+			const int otherIndex = GetLayer(other);
+			if(otherIndex < 0){
+				Debug::LogWarning("Collision layer " + section.first + " collides with unknown layer " + other + "!", __FILE__, __LINE__);
+				continue;
+			}
+
+			//Collisions only happen if both sides allow it, so keep the matrix symmetric
+			layers[index].collideWith |= CategoryBits(otherIndex);
+			layers[otherIndex].collideWith |= CategoryBits(index);
+		}
+	}
+
+	return true;
+}
+
+void CollisionLayers::Destroy(){
+	layers.clear();
+	layerIndices.clear();
+}
+
+int CollisionLayers::GetLayer(const std::string& layerName_){
+	const auto index = layerIndices.find(ToLower(layerName_));
+	if(index == layerIndices.end()){
+		return -1;
+	}
+
+	return index->second;
+}
+
+std::string CollisionLayers::GetLayerName(int layer_){
+	_ASSERT(layer_ >= 0 && layer_ < maxLayers);
+	return layers[layer_].name;
+}
+
+unsigned short CollisionLayers::CategoryBits(int layer_){
+	_ASSERT(layer_ >= 0 && layer_ < maxLayers);
+	return static_cast<unsigned short>(1 << layer_);
+}
+
+unsigned short CollisionLayers::CollideWithBits(int layer_){
+	_ASSERT(layer_ >= 0 && layer_ < maxLayers);
+	return layers[layer_].collideWith;
+}
+
+bool CollisionLayers::EventsEnabled(int layer_){
+	_ASSERT(layer_ >= 0 && layer_ < maxLayers);
+	return layers[layer_].events;
+}
+
+int CollisionLayers::LayerFromCategoryBits(unsigned short categoryBits_){
+	for(int i = 0; i < maxLayers; i++){
+		if(categoryBits_ & CategoryBits(i)){
+			return i;
+		}
+	}
+
+	return defaultLayer;
+}
+
+unsigned short CollisionLayers::LayerMask(const std::vector<std::string>& layerNames_){
+	unsigned short mask = 0;
+	for(const std::string& name : layerNames_){
+		const int index = GetLayer(name);
+		if(index < 0){
+			Debug::LogWarning("Unknown collision layer " + name + "!", __FILE__, __LINE__);
+			continue;
+		}
+
+		mask |= CategoryBits(index);
+	}
+
+	return mask;
+}
+
+void CollisionLayers::SetDefaultLayers(){
+	layers = std::vector<LayerInfo>(maxLayers);
+	layerIndices.clear();
+
+	//Everything starts out on the default layer, which collides with everything
+	layers[defaultLayer].name = "default";
+	layers[defaultLayer].isUsed = true;
+	layers[defaultLayer].collideWith = 0xFFFF;
+	layerIndices["default"] = defaultLayer;
+
+	//Unnamed layers still collide with everything so that stray category bits behave like the default layer
+	for(LayerInfo& layer : layers){
+		if(!layer.isUsed){
+			layer.collideWith = 0xFFFF;
+		}
+	}
+}
+
+bool CollisionLayers::ParseInt(const std::string& value_, int& result_){
+	const std::string trimmed = Trim(value_);
+	if(trimmed.empty()){
+		return false;
+	}
+
+	char* end = nullptr;
+	const long value = std::strtol(trimmed.c_str(), &end, 10);
+	if(*end != '\0' || value < INT_MIN || value > INT_MAX){
+		return false;
+	}
+
+	result_ = static_cast<int>(value);
+	return true;
+}
+
+std::string CollisionLayers::Trim(const std::string& value_){
+	const size_t first = value_.find_first_not_of(" \t");
+	if(first == std::string::npos){
+		return std::string();
+	}
+
+	return value_.substr(first, value_.find_last_not_of(" \t") - first + 1);
+}
+
+std::string CollisionLayers::ToLower(const std::string& value_){
+	std::string result;
+	std::transform(value_.begin(), value_.end(), std::back_inserter(result), tolower);
+	return result;
+}
+
+void CollisionLayers::WriteDefaultFile(){
+	std::map<std::string, std::map<std::string, std::string>> records;
+	records["Default"]["Bit"] = std::to_string(defaultLayer);
+	records["Default"]["CollidesWith"] = "All";
+	records["Default"]["Events"] = "1";
+
+	FileSystem::WriteRecords(layerFile, records);
+}
\ No newline at end of file
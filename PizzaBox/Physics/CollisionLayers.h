@@ -0,0 +1,61 @@
+#ifndef COLLISION_LAYERS_H
+#define COLLISION_LAYERS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace PizzaBox{
+	//Named collision layers loaded from CollisionLayers.ini
+	//Each layer is one bit of ReactPhysics' 16 category bits, and the ini decides which layers collide and which raise script events
+	class CollisionLayers{
+	public:
+		static constexpr int maxLayers = 16;
+		static constexpr int defaultLayer = 0;
+
+		static bool Initialize();
+		static void Destroy();
+
+		static int GetLayer(const std::string& layerName_);
+		static std::string GetLayerName(int layer_);
+		static unsigned short CategoryBits(int layer_);
+		static unsigned short CollideWithBits(int layer_);
+		static bool EventsEnabled(int layer_);
+		//Finds the layer a set of ReactPhysics category bits belongs to
+		static int LayerFromCategoryBits(unsigned short categoryBits_);
+		//Combines the category bits of several layers, for use as a query mask
+		static unsigned short LayerMask(const std::vector<std::string>& layerNames_);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		CollisionLayers() = delete;
+		CollisionLayers(const CollisionLayers&) = delete;
+		CollisionLayers(CollisionLayers&&) = delete;
+		CollisionLayers& operator=(const CollisionLayers&) = delete;
+		CollisionLayers& operator=(CollisionLayers&&) = delete;
+		~CollisionLayers() = delete;
+
+	private:
+		struct LayerInfo{
+			LayerInfo() : name(), collideWith(0), events(true), isUsed(false){}
+
+			std::string name;
+			unsigned short collideWith;
+			bool events;
+			bool isUsed;
+		};
+
+		static const std::string layerFile;
+		static std::vector<LayerInfo> layers;
+		static std::map<std::string, int> layerIndices;
+
+		static void SetDefaultLayers();
+		static void WriteDefaultFile();
+
+		//Returns false instead of throwing if value_ isn't a whole number
+		static bool ParseInt(const std::string& value_, int& result_);
+		static std::string Trim(const std::string& value_);
+		static std::string ToLower(const std::string& value_);
+	};
+}
+
+#endif //!COLLISION_LAYERS_H
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include "CollisionShapeCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <experimental/filesystem>
+#include <sstream>
+
+#include "Core/Config.h"
+#include "Core/FileSystem.h"
+#include "Core/MappedFile.h"
+#include "Graphics/Models/Model.h"
+#include "Resource/ResourceManager.h"
+#include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
+
+using namespace PizzaBox;
+
+namespace{
+	const char cookedMeshTag[] = "PBCOL2";
+	const char cookedMeshDirectory[] = "Resources/Cooked/";
+}
+
+//Initialize static variables here
+bool CollisionShapeCache::persistCookedMeshes = false;
+std::map<std::string, CollisionShapeCache::CookedMesh*> CollisionShapeCache::meshes;
+std::map<std::string, CollisionShapeCache::CookedShape*> CollisionShapeCache::shapes;
+std::unordered_map<const rp3d::CollisionShape*, CollisionShapeCache::CookedShape*> CollisionShapeCache::shapeOwners;
+
+CollisionShapeCache::CookedMesh::~CookedMesh(){
+	if(polyhedron != nullptr){
+		delete polyhedron;
+		polyhedron = nullptr;
+	}
+
+	if(polygonArray != nullptr){
+		delete polygonArray;
+		polygonArray = nullptr;
+	}
+
+	if(triangleMesh != nullptr){
+		delete triangleMesh;
+		triangleMesh = nullptr;
+	}
+
+	if(triangleArray != nullptr){
+		delete triangleArray;
+		triangleArray = nullptr;
+	}
+}
+
+bool CollisionShapeCache::Initialize(){
+	persistCookedMeshes = Config::GetBool("CacheCookedColliders");
+	return true;
+}
+
+void CollisionShapeCache::Destroy(){
+	#ifdef _DEBUG
+	if(!shapes.empty()){
+		Debug::LogWarning(std::to_string(shapes.size()) + " cooked collision shapes were never released!", __FILE__, __LINE__);
+	}
+	#endif //_DEBUG
+
+	for(auto& s : shapes){
+		delete s.second->shape;
+		s.second->shape = nullptr;
+		delete s.second;
+		s.second = nullptr;
+	}
+
+	for(auto& m : meshes){
+		delete m.second;
+		m.second = nullptr;
+	}
+
+	shapes.clear();
+	meshes.clear();
+	shapeOwners.clear();
+}
+
+rp3d::ConvexMeshShape* CollisionShapeCache::LoadConvexShape(const std::string& modelName_, const Vector3& scale_){
+	_ASSERT(!modelName_.empty());
+
+	std::string meshName;
+	std::transform(modelName_.begin(), modelName_.end(), std::back_inserter(meshName), tolower);
+
+	const std::string key = ShapeKey("Convex", meshName, scale_);
+	CookedShape* cooked = FindShape(key);
+	if(cooked != nullptr){
+		return static_cast<rp3d::ConvexMeshShape*>(cooked->shape);
+	}
+
+	CookedMesh* mesh = LoadMesh(meshName, modelName_);
+	if(mesh == nullptr){
+		return nullptr;
+	}
+
+	if(mesh->polyhedron == nullptr){
+		mesh->polygonArray = new rp3d::PolygonVertexArray(static_cast<rp3d::uint>(mesh->vertices.size() / 3), mesh->vertices.data(), static_cast<int>(3 * sizeof(float)),
+			mesh->indices.data(), static_cast<int>(sizeof(int)), static_cast<rp3d::uint>(mesh->faces.size()), mesh->faces.data(),
+			rp3d::PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+			rp3d::PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+		mesh->polyhedron = new rp3d::PolyhedronMesh(mesh->polygonArray);
+	}
+
+	rp3d::ConvexMeshShape* shape = new rp3d::ConvexMeshShape(mesh->polyhedron, rp3d::Vector3(scale_.x, scale_.y, scale_.z));
+	cooked = new CookedShape(key, meshName, shape);
+	AddShape(cooked);
+	return shape;
+}
+
+rp3d::ConcaveMeshShape* CollisionShapeCache::LoadConcaveShape(const std::string& modelName_, const Vector3& scale_){
+	_ASSERT(!modelName_.empty());
+
+	std::string meshName;
+	std::transform(modelName_.begin(), modelName_.end(), std::back_inserter(meshName), tolower);
+
+	const std::string key = ShapeKey("Concave", meshName, scale_);
+	CookedShape* cooked = FindShape(key);
+	if(cooked != nullptr){
+		return static_cast<rp3d::ConcaveMeshShape*>(cooked->shape);
+	}
+
+	CookedMesh* mesh = LoadMesh(meshName, modelName_);
+	if(mesh == nullptr){
+		return nullptr;
+	}
+
+	if(mesh->triangleMesh == nullptr){
+		mesh->triangleArray = new rp3d::TriangleVertexArray(static_cast<rp3d::uint>(mesh->vertices.size() / 3), mesh->vertices.data(), static_cast<int>(3 * sizeof(float)),
+			static_cast<rp3d::uint>(mesh->indices.size() / 3), mesh->indices.data(), static_cast<rp3d::uint>(3 * sizeof(int)),
+			rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+			rp3d::TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+		mesh->triangleMesh = new rp3d::TriangleMesh();
+		mesh->triangleMesh->addSubpart(mesh->triangleArray);
+	}
+
+	rp3d::ConcaveMeshShape* shape = new rp3d::ConcaveMeshShape(mesh->triangleMesh, rp3d::Vector3(scale_.x, scale_.y, scale_.z));
+	cooked = new CookedShape(key, meshName, shape);
+	AddShape(cooked);
+	return shape;
+}
+
+void CollisionShapeCache::AddReference(const rp3d::CollisionShape* shape_){
+	auto owner = shapeOwners.find(shape_);
+	if(owner == shapeOwners.end()){
+		Debug::LogWarning("Tried to reference a collision shape that isn't in the cache!", __FILE__, __LINE__);
+		return;
+	}
+
+	owner->second->refCount++;
+}
+
+void CollisionShapeCache::ReleaseShape(const rp3d::CollisionShape* shape_){
+	auto owner = shapeOwners.find(shape_);
+	if(owner == shapeOwners.end()){
+		Debug::LogWarning("Tried to release a collision shape that isn't in the cache!", __FILE__, __LINE__);
+		return;
+	}
+
+	CookedShape* cooked = owner->second;
+	_ASSERT(cooked->refCount > 0);
+	cooked->refCount--;
+
+	if(cooked->refCount > 0){
+		return;
+	}
+
+	const std::string meshName = cooked->meshName;
+
+	shapeOwners.erase(owner);
+	shapes.erase(cooked->key);
+	delete cooked->shape;
+	cooked->shape = nullptr;
+	delete cooked;
+	cooked = nullptr;
+
+	ReleaseMesh(meshName);
+	EngineStats::SetInt("Cooked Collision Shapes", static_cast<long long>(shapes.size()));
+}
+
+CollisionShapeCache::CookedMesh* CollisionShapeCache::LoadMesh(const std::string& meshName_, const std::string& modelName_){
+	auto existing = meshes.find(meshName_);
+	if(existing != meshes.end()){
+		existing->second->refCount++;
+		return existing->second;
+	}
+
+	Debug::StartProfiling("Collision Shape Cooking");
+
+	CookedMesh* mesh = new CookedMesh();
+	//A cooked mesh is only used if it was cooked from the model as it is now
+	const uint64_t sourceHash = persistCookedMeshes ? SourceHash(modelName_) : 0;
+	if(!(persistCookedMeshes && ReadCookedMesh(meshName_, sourceHash, mesh))){
+		if(!CookMesh(modelName_, mesh)){
+			delete mesh;
+			Debug::EndProfiling("Collision Shape Cooking");
+			return nullptr;
+		}
+
+		if(persistCookedMeshes){
+			WriteCookedMesh(meshName_, sourceHash, mesh);
+		}
+	}
+
+	//Every face is a triangle, so the faces can be worked out from the index count alone
+	const size_t numFaces = mesh->indices.size() / 3;
+	mesh->faces.resize(numFaces);
+	for(size_t f = 0; f < numFaces; f++){
+		mesh->faces[f].indexBase = static_cast<rp3d::uint>(f * 3);
+		mesh->faces[f].nbVertices = 3;
+	}
+
+	Debug::EndProfiling("Collision Shape Cooking");
+
+	mesh->refCount++;
+	meshes.insert(std::pair<std::string, CookedMesh*>(meshName_, mesh));
+	return mesh;
+}
+
+bool CollisionShapeCache::CookMesh(const std::string& modelName_, CookedMesh* mesh_){
+	Model* model = ResourceManager::LoadResource<Model>(modelName_);
+	if(model == nullptr){
+		Debug::LogError("Could not load model " + modelName_ + " for collision!", __FILE__, __LINE__);
+		return false;
+	}
+
+	for(const auto& m : model->meshList){
+		//Indices are relative to their own mesh, so offset them to where this mesh's vertices start
+		const int indexOffset = static_cast<int>(mesh_->vertices.size() / 3);
+
+		for(const auto& v : m->vertices){
+			mesh_->vertices.push_back(v.position.x);
+			mesh_->vertices.push_back(v.position.y);
+			mesh_->vertices.push_back(v.position.z);
+		}
+
+		for(const auto& i : m->indices){
+			mesh_->indices.push_back(static_cast<int>(i) + indexOffset);
+		}
+	}
+
+	ResourceManager::UnloadResource(modelName_);
+	return true;
+}
+
+bool CollisionShapeCache::ReadCookedMesh(const std::string& meshName_, uint64_t sourceHash_, CookedMesh* mesh_){
+	const std::string path = CookedMeshPath(meshName_);
+	if(!FileSystem::FileExists(path)){
+		return false;
+	}
+
+	//Mapped rather than read, the vertices and indices are copied straight out of it below
+	const MappedFile file(path);
+	const StringView data = file.View();
+
+	const size_t headerSize = sizeof(cookedMeshTag) + sizeof(uint64_t) + 2 * sizeof(unsigned int);
+	if(data.size() < headerSize || std::memcmp(data.data(), cookedMeshTag, sizeof(cookedMeshTag)) != 0){
+		Debug::LogWarning("Cooked collision mesh " + path + " is invalid, it will be rebuilt!", __FILE__, __LINE__);
+		return false;
+	}
+
+	const char* cursor = data.data() + sizeof(cookedMeshTag);
+	uint64_t cookedHash = 0;
+	std::memcpy(&cookedHash, cursor, sizeof(uint64_t));
+	cursor += sizeof(uint64_t);
+
+	if(cookedHash != sourceHash_){
+		Debug::Log("Cooked collision mesh " + path + " is older than its model, it will be rebuilt", __FILE__, __LINE__);
+		return false;
+	}
+
+	unsigned int numVertexFloats = 0;
+	unsigned int numIndices = 0;
+	std::memcpy(&numVertexFloats, cursor, sizeof(unsigned int));
+	std::memcpy(&numIndices, cursor + sizeof(unsigned int), sizeof(unsigned int));
+
+	if(data.size() != headerSize + numVertexFloats * sizeof(float) + numIndices * sizeof(int)){
+		Debug::LogWarning("Cooked collision mesh " + path + " is the wrong size, it will be rebuilt!", __FILE__, __LINE__);
+		return false;
+	}
+
+	mesh_->vertices.resize(numVertexFloats);
+	mesh_->indices.resize(numIndices);
+	std::memcpy(mesh_->vertices.data(), data.data() + headerSize, numVertexFloats * sizeof(float));
+	std::memcpy(mesh_->indices.data(), data.data() + headerSize + numVertexFloats * sizeof(float), numIndices * sizeof(int));
+	return true;
+}
+
+void CollisionShapeCache::WriteCookedMesh(const std::string& meshName_, uint64_t sourceHash_, const CookedMesh* mesh_){
+	const unsigned int numVertexFloats = static_cast<unsigned int>(mesh_->vertices.size());
+	const unsigned int numIndices = static_cast<unsigned int>(mesh_->indices.size());
+
+	std::vector<char> data = std::vector<char>(sizeof(cookedMeshTag) + sizeof(uint64_t) + 2 * sizeof(unsigned int) + numVertexFloats * sizeof(float) + numIndices * sizeof(int));
+	char* cursor = data.data();
+
+	std::memcpy(cursor, cookedMeshTag, sizeof(cookedMeshTag));
+	cursor += sizeof(cookedMeshTag);
+	std::memcpy(cursor, &sourceHash_, sizeof(uint64_t));
+	cursor += sizeof(uint64_t);
+	std::memcpy(cursor, &numVertexFloats, sizeof(unsigned int));
+	cursor += sizeof(unsigned int);
+	std::memcpy(cursor, &numIndices, sizeof(unsigned int));
+	cursor += sizeof(unsigned int);
+	std::memcpy(cursor, mesh_->vertices.data(), numVertexFloats * sizeof(float));
+	cursor += numVertexFloats * sizeof(float);
+	std::memcpy(cursor, mesh_->indices.data(), numIndices * sizeof(int));
+
+	//The cooked directory isn't part of the repository, so make it the first time anything is cooked
+	std::error_code error;
+	std::experimental::filesystem::create_directories(cookedMeshDirectory, error);
+	if(error){
+		Debug::LogWarning("Could not create " + std::string(cookedMeshDirectory) + ", cooked collision meshes won't be saved!", __FILE__, __LINE__);
+		return;
+	}
+
+	FileSystem::WriteBinaryFile(CookedMeshPath(meshName_), data);
+}
+
+std::string CollisionShapeCache::CookedMeshPath(const std::string& meshName_){
+	return std::string(cookedMeshDirectory) + meshName_ + ".collision";
+}
+
+uint64_t CollisionShapeCache::SourceHash(const std::string& modelName_){
+	const std::string sourceFile = ResourceManager::GetFileName(modelName_);
+	if(sourceFile.empty() || !FileSystem::FileExists(sourceFile)){
+		return 0;
+	}
+
+	//64 bit FNV-1a over the whole model, which is still far cheaper than importing it
+	const MappedFile source(sourceFile);
+	uint64_t hash = 14695981039346656037ull;
+	for(char c : source.View()){
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+std::string CollisionShapeCache::ShapeKey(const std::string& type_, const std::string& meshName_, const Vector3& scale_){
+	std::stringstream key;
+	key << type_ << "|" << meshName_ << "|" << scale_.x << "," << scale_.y << "," << scale_.z;
+	return key.str();
+}
+
+CollisionShapeCache::CookedShape* CollisionShapeCache::FindShape(const std::string& key_){
+	auto existing = shapes.find(key_);
+	if(existing == shapes.end()){
+		return nullptr;
+	}
+
+	EngineStats::AddToInt("Collision Shape Cache Hits", 1);
+	existing->second->refCount++;
+	return existing->second;
+}
+
+void CollisionShapeCache::AddShape(CookedShape* shape_){
+	shape_->refCount++;
+	shapes.insert(std::pair<std::string, CookedShape*>(shape_->key, shape_));
+	shapeOwners.insert(std::pair<const rp3d::CollisionShape*, CookedShape*>(shape_->shape, shape_));
+	EngineStats::SetInt("Cooked Collision Shapes", static_cast<long long>(shapes.size()));
+}
+
+void CollisionShapeCache::ReleaseMesh(const std::string& meshName_){
+	auto mesh = meshes.find(meshName_);
+	_ASSERT(mesh != meshes.end());
+
+	_ASSERT(mesh->second->refCount > 0);
+	mesh->second->refCount--;
+
+	if(mesh->second->refCount == 0){
+		delete mesh->second;
+		mesh->second = nullptr;
+		meshes.erase(mesh);
+	}
+}
\ No newline at end of file
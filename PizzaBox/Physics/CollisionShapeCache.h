@@ -0,0 +1,80 @@
+#ifndef COLLISION_SHAPE_CACHE_H
+#define COLLISION_SHAPE_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <reactphysics3d.h>
+
+#include "Math/Vector.h"
+
+namespace PizzaBox{
+	//Shares cooked mesh collision shapes between every collider built from the same model at the same scale
+	class CollisionShapeCache{
+	public:
+		static bool Initialize();
+		static void Destroy();
+
+		static rp3d::ConvexMeshShape* LoadConvexShape(const std::string& modelName_, const Vector3& scale_);
+		static rp3d::ConcaveMeshShape* LoadConcaveShape(const std::string& modelName_, const Vector3& scale_);
+		static void AddReference(const rp3d::CollisionShape* shape_);
+		static void ReleaseShape(const rp3d::CollisionShape* shape_);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		CollisionShapeCache() = delete;
+		CollisionShapeCache(const CollisionShapeCache&) = delete;
+		CollisionShapeCache(CollisionShapeCache&&) = delete;
+		CollisionShapeCache& operator=(const CollisionShapeCache&) = delete;
+		CollisionShapeCache& operator=(CollisionShapeCache&&) = delete;
+		~CollisionShapeCache() = delete;
+
+	private:
+		//Geometry pulled out of a model, shared by every scale of every shape built from it
+		struct CookedMesh{
+			CookedMesh() : vertices(), indices(), faces(), polygonArray(nullptr), polyhedron(nullptr), triangleArray(nullptr), triangleMesh(nullptr), refCount(0){}
+			~CookedMesh();
+
+			std::vector<float> vertices;
+			std::vector<int> indices;
+			std::vector<rp3d::PolygonVertexArray::PolygonFace> faces;
+
+			rp3d::PolygonVertexArray* polygonArray;
+			rp3d::PolyhedronMesh* polyhedron;
+			rp3d::TriangleVertexArray* triangleArray;
+			rp3d::TriangleMesh* triangleMesh;
+
+			unsigned int refCount;
+		};
+
+		struct CookedShape{
+			CookedShape(const std::string& key_, const std::string& meshName_, rp3d::CollisionShape* shape_) : key(key_), meshName(meshName_), shape(shape_), refCount(0){}
+
+			std::string key;
+			std::string meshName;
+			rp3d::CollisionShape* shape;
+			unsigned int refCount;
+		};
+
+		static bool persistCookedMeshes;
+		static std::map<std::string, CookedMesh*> meshes;
+		static std::map<std::string, CookedShape*> shapes;
+		static std::unordered_map<const rp3d::CollisionShape*, CookedShape*> shapeOwners;
+
+		static CookedMesh* LoadMesh(const std::string& meshName_, const std::string& modelName_);
+		static bool CookMesh(const std::string& modelName_, CookedMesh* mesh_);
+		//Cooked meshes store a hash of the model they were cooked from, so they're rebuilt whenever the model changes
+		static bool ReadCookedMesh(const std::string& meshName_, uint64_t sourceHash_, CookedMesh* mesh_);
+		static void WriteCookedMesh(const std::string& meshName_, uint64_t sourceHash_, const CookedMesh* mesh_);
+		static std::string CookedMeshPath(const std::string& meshName_);
+		static uint64_t SourceHash(const std::string& modelName_);
+		static std::string ShapeKey(const std::string& type_, const std::string& meshName_, const Vector3& scale_);
+		static CookedShape* FindShape(const std::string& key_);
+		static void AddShape(CookedShape* shape_);
+		static void ReleaseMesh(const std::string& meshName_);
+	};
+}
+
+#endif //!COLLISION_SHAPE_CACHE_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "PhysicsDeterminismCheck.h"
+
+#include <string>
+
+#include "Collider.h"
+#include "PhysicsEngine.h"
+#include "Rigidbody.h"
+#include "Core/Scene.h"
+#include "Tools/Debug.h"
+
+using namespace PizzaBox;
+
+namespace{
+	//Nothing is set up in advance, every object comes from the scripted sequence in Simulate
+	class CheckScene : public Scene{
+	public:
+		bool Initialize() override{ return true; }
+	};
+
+	void Sample(const GameObject* go_, std::vector<float>& samples_){
+		const Vector3 position = go_->GetPosition();
+		const Quaternion rotation = go_->GetRotationQuat();
+
+		samples_.push_back(position.x);
+		samples_.push_back(position.y);
+		samples_.push_back(position.z);
+		samples_.push_back(rotation.w);
+		samples_.push_back(rotation.x);
+		samples_.push_back(rotation.y);
+		samples_.push_back(rotation.z);
+	}
+}
+
+bool PhysicsDeterminismCheck::Run(int frames_, float deltaTime_){
+	std::vector<float> serialSamples;
+	std::vector<float> threadedSamples;
+
+	if(Simulate(false, frames_, deltaTime_, serialSamples) == false || Simulate(true, frames_, deltaTime_, threadedSamples) == false){
+		Debug::LogError("Physics determinism check could not run!", __FILE__, __LINE__);
+		return false;
+	}
+
+	if(serialSamples.size() != threadedSamples.size()){
+		Debug::LogError("Serial and threaded physics saw a different number of bodies!", __FILE__, __LINE__);
+		return false;
+	}
+
+	//Both modes do the same floating point work in the same order, so anything short of an exact match is a bug
+	for(size_t i = 0; i < serialSamples.size(); i++){
+		if(serialSamples[i] != threadedSamples[i]){
+			Debug::LogError("Serial and threaded physics diverged at sample " + std::to_string(i) + ": " + std::to_string(serialSamples[i]) + " vs " + std::to_string(threadedSamples[i]), __FILE__, __LINE__);
+			return false;
+		}
+	}
+
+	Debug::Log("Serial and threaded physics matched over " + std::to_string(frames_) + " frames", __FILE__, __LINE__);
+	return true;
+}
+
+bool PhysicsDeterminismCheck::Simulate(bool threaded_, int frames_, float deltaTime_, std::vector<float>& samples_){
+	if(PhysicsEngine::Initialize() == false){
+		return false;
+	}
+
+	PhysicsEngine::SetThreadedStep(threaded_);
+
+	Scene* scene = new CheckScene();
+	std::vector<GameObject*> bodies;
+	bool succeeded = true;
+
+	for(int frame = 0; frame < frames_ && succeeded; frame++){
+		//This follows GameManager's loop, minus everything that doesn't touch physics or the scene
+		PhysicsEngine::Update(deltaTime_);
+
+		//Game logic
+		for(const GameObject* go : bodies){
+			Sample(go, samples_);
+		}
+
+		if(frame == 0){
+			GameObject* ground = scene->CreateObject<GameObject>(Vector3(0.0f, -1.0f, 0.0f));
+			ground->SetStatic(true);
+			ground->AddComponent(new Collider(Vector3(40.0f, 1.0f, 40.0f)));
+		}
+
+		//Drop a body every few frames so that they land on each other, then start taking the oldest ones away
+		if(frame % 5 == 0 && frame < frames_ / 2){
+			const int i = frame / 5;
+			GameObject* body = scene->CreateObject<GameObject>(Vector3(static_cast<float>(i % 3) * 0.4f - 0.4f, 4.0f + static_cast<float>(i % 4), static_cast<float>(i % 5) * 0.3f - 0.6f));
+			Rigidbody* rb = new Rigidbody(1.0f);
+			if(i % 2 == 0){
+				rb->AddCollider(new BoxCollider(Vector3(1.0f, 1.0f, 1.0f)));
+			}else{
+				rb->AddCollider(new SphereCollider(0.5f));
+			}
+
+			body->AddComponent(rb);
+			bodies.push_back(body);
+		}
+
+		if(frame % 7 == 0 && frame >= frames_ / 4 && bodies.size() > 4){
+			scene->DestroyObject(bodies.front());
+			bodies.erase(bodies.begin());
+		}
+
+		if(frame == (frames_ * 3) / 4 && bodies.size() > 3){
+			scene->DestroyObjects(std::vector<GameObject*>(bodies.begin(), bodies.begin() + 3));
+			bodies.erase(bodies.begin(), bodies.begin() + 3);
+		}
+
+		succeeded = scene->Update();
+		PhysicsEngine::StartStep();
+		PhysicsEngine::FinishStep();
+	}
+
+	scene->Destroy();
+	delete scene;
+	scene = nullptr;
+
+	PhysicsEngine::Destroy();
+	return succeeded;
+}
\ No newline at end of file
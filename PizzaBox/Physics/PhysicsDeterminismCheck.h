@@ -0,0 +1,27 @@
+#ifndef PHYSICS_DETERMINISM_CHECK_H
+#define PHYSICS_DETERMINISM_CHECK_H
+
+#include <vector>
+
+namespace PizzaBox{
+	//Runs the same scripted spawn/destroy sequence with serial and threaded physics, and checks that every body ends up in the same place
+	//Needs Debug, EngineStats, FileSystem and Config, but nothing that opens a window
+	class PhysicsDeterminismCheck{
+	public:
+		static bool Run(int frames_ = 600, float deltaTime_ = 1.0f / 60.0f);
+
+		//Delete unwanted compiler generated constructors, assignment operators and destructors
+		PhysicsDeterminismCheck() = delete;
+		PhysicsDeterminismCheck(const PhysicsDeterminismCheck&) = delete;
+		PhysicsDeterminismCheck(PhysicsDeterminismCheck&&) = delete;
+		PhysicsDeterminismCheck& operator=(const PhysicsDeterminismCheck&) = delete;
+		PhysicsDeterminismCheck& operator=(PhysicsDeterminismCheck&&) = delete;
+		~PhysicsDeterminismCheck() = delete;
+
+	private:
+		//Every live body's position and rotation, as scripts would see them at the start of each frame's game logic
+		static bool Simulate(bool threaded_, int frames_, float deltaTime_, std::vector<float>& samples_);
+	};
+}
+
+#endif //!PHYSICS_DETERMINISM_CHECK_H
\ No newline at end of file
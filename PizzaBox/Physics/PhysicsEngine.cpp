@@ -1,22 +1,309 @@
 #include "PhysicsEngine.h"
 
 #include <algorithm>
+#include <cmath>
+#include <future>
+#include <unordered_set>
 
+#include <rttr/registration.h>
 #include <collision/ContactManifold.h>
 #include <constraint/ContactPoint.h>
 
-#include "Script/Script.h"
+#include "CollisionLayers.h"
+#include "CollisionShapeCache.h"
+#include "Core/Config.h"
+#include "Script/ScriptManager.h"
 #include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
 
 using namespace PizzaBox;
 
+namespace{
+	RaycastInfo ToRaycastInfo(const rp3d::RaycastInfo& info_){
+		const Component* component = static_cast<const Component*>(info_.body->getUserData());
+
+		return RaycastInfo(
+			Vector3(info_.worldPoint.x, info_.worldPoint.y, info_.worldPoint.z),
+			Vector3(info_.worldNormal.x, info_.worldNormal.y, info_.worldNormal.z),
+			info_.hitFraction, component->GetGameObject()
+		);
+	}
+
+	bool IsRaycastTarget(const rp3d::RaycastInfo& info_){
+		const Component* component = static_cast<const Component*>(info_.body->getUserData());
+		return (component != nullptr && component->GetEnable());
+	}
+
+	//Collects every enabled body the ray passes through
+	class AllHitsCallback : public rp3d::RaycastCallback{
+	public:
+		std::vector<RaycastInfo> hits;
+
+		virtual rp3d::decimal notifyRaycastHit(const rp3d::RaycastInfo& info_) override{
+			if(!IsRaycastTarget(info_)){
+				//Ignore this shape and keep going
+				return rp3d::decimal(-1.0);
+			}
+
+			hits.push_back(ToRaycastInfo(info_));
+			return rp3d::decimal(1.0);
+		}
+	};
+
+	//Keeps the closest enabled body, clipping the ray to each hit so the broadphase can skip anything further away
+	class NearestHitCallback : public rp3d::RaycastCallback{
+	public:
+		NearestHitCallback() : hit(), hasHit(false){}
+
+		RaycastInfo hit;
+		bool hasHit;
+
+		virtual rp3d::decimal notifyRaycastHit(const rp3d::RaycastInfo& info_) override{
+			if(!IsRaycastTarget(info_)){
+				return rp3d::decimal(-1.0);
+			}
+
+			if(!hasHit || info_.hitFraction < hit.hitFraction){
+				hit = ToRaycastInfo(info_);
+				hasHit = true;
+			}
+
+			return info_.hitFraction;
+		}
+	};
+
+	rp3d::Ray ToRay(const Vector3& start_, const Vector3& end_){
+		return rp3d::Ray(rp3d::Vector3(start_.x, start_.y, start_.z), rp3d::Vector3(end_.x, end_.y, end_.z));
+	}
+
+	//Collects the owners of every enabled body touching the query shape, each object is only reported once
+	class OverlapResultCallback : public rp3d::OverlapCallback{
+	public:
+		std::vector<GameObject*> results;
+
+		virtual void notifyOverlap(rp3d::CollisionBody* body_) override{
+			const Component* component = static_cast<const Component*>(body_->getUserData());
+			if(component == nullptr || !component->GetEnable()){
+				return;
+			}
+
+			if(found.insert(component->GetGameObject()).second){
+				results.push_back(component->GetGameObject());
+			}
+		}
+
+	private:
+		std::unordered_set<const GameObject*> found;
+	};
+
+	//Collects the moving objects with events enabled whose broadphase bounds touch a trigger volume
+	class TriggerOverlapCallback : public rp3d::OverlapCallback{
+	public:
+		explicit TriggerOverlapCallback(const GameObject* trigger_) : results(), trigger(trigger_){}
+
+		std::vector<GameObject*> results;
+
+		virtual void notifyOverlap(rp3d::CollisionBody* body_) override{
+			//Static geometry never enters or leaves a trigger
+			if(body_->getType() == rp3d::BodyType::STATIC){
+				return;
+			}
+
+			const Component* component = static_cast<const Component*>(body_->getUserData());
+			if(component == nullptr || !component->GetEnable() || component->GetGameObject() == trigger){
+				return;
+			}
+
+			//Like contacts, an overlap only reaches scripts if both objects' layers have events turned on
+			const rp3d::ProxyShape* shape = body_->getProxyShapesList();
+			if(shape == nullptr || !CollisionLayers::EventsEnabled(CollisionLayers::LayerFromCategoryBits(shape->getCollisionCategoryBits()))){
+				return;
+			}
+
+			results.push_back(component->GetGameObject());
+		}
+
+	private:
+		const GameObject* trigger;
+	};
+
+	//Collects every enabled body touching the query shape, grouped by the object that owns it
+	class CandidateBodyCallback : public rp3d::OverlapCallback{
+	public:
+		std::vector<std::pair<GameObject*, std::vector<rp3d::CollisionBody*>>> results;
+
+		virtual void notifyOverlap(rp3d::CollisionBody* body_) override{
+			const Component* component = static_cast<const Component*>(body_->getUserData());
+			if(component == nullptr || !component->GetEnable()){
+				return;
+			}
+
+			const auto found = indices.find(component->GetGameObject());
+			if(found != indices.end()){
+				results[found->second].second.push_back(body_);
+				return;
+			}
+
+			indices.insert(std::make_pair(component->GetGameObject(), results.size()));
+			results.push_back(std::make_pair(component->GetGameObject(), std::vector<rp3d::CollisionBody*>{ body_ }));
+		}
+
+	private:
+		std::unordered_map<const GameObject*, size_t> indices;
+	};
+
+	//Keeps the first contact normal between the cast sphere and whatever it touched, turned to face back towards the sphere
+	class SphereCastContactCallback : public rp3d::CollisionCallback{
+	public:
+		explicit SphereCastContactCallback(const rp3d::CollisionBody* sphere_) : hasContact(false), normal(), sphere(sphere_){}
+
+		bool hasContact;
+		rp3d::Vector3 normal;
+
+		virtual void notifyContact(const CollisionCallbackInfo& info_) override{
+			for(rp3d::ContactManifoldListElement* element = info_.contactManifoldElements; element != nullptr && !hasContact; element = element->getNext()){
+				const rp3d::ContactManifold* manifold = element->getContactManifold();
+				const rp3d::ContactPoint* contact = manifold->getContactPoints();
+				if(contact == nullptr){
+					continue;
+				}
+
+				//Contact normals point from the manifold's first body towards its second
+				normal = (manifold->getBody1() == sphere) ? -contact->getNormal() : contact->getNormal();
+				hasContact = true;
+			}
+		}
+
+	private:
+		const rp3d::CollisionBody* sphere;
+	};
+
+	bool TouchesAny(rp3d::CollisionWorld* world_, rp3d::CollisionBody* sphere_, const std::vector<rp3d::CollisionBody*>& bodies_, const rp3d::Vector3& position_){
+		sphere_->setTransform(rp3d::Transform(position_, rp3d::Quaternion::identity()));
+
+		for(rp3d::CollisionBody* body : bodies_){
+			if(world_->testOverlap(sphere_, body)){
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	constexpr int maxSphereCastSteps = 256;
+	constexpr int sphereCastBisections = 16;
+
+	//Finds how far along the path the sphere first touches any of the bodies, or returns false if it never does
+	//The path is walked in steps no longer than the radius so the sphere can't jump over anything, then the step that hit is bisected
+	bool SphereTimeOfImpact(rp3d::CollisionWorld* world_, rp3d::CollisionBody* sphere_, const std::vector<rp3d::CollisionBody*>& bodies_, const rp3d::Vector3& start_, const rp3d::Vector3& path_, float radius_, float& fraction_){
+		if(TouchesAny(world_, sphere_, bodies_, start_)){
+			fraction_ = 0.0f;
+			return true;
+		}
+
+		const int steps = std::min(std::max(static_cast<int>(std::ceil(path_.length() / radius_)), 1), maxSphereCastSteps);
+
+		float previous = 0.0f;
+		for(int i = 1; i <= steps; i++){
+			const float current = static_cast<float>(i) / static_cast<float>(steps);
+			if(!TouchesAny(world_, sphere_, bodies_, start_ + (path_ * current))){
+				previous = current;
+				continue;
+			}
+
+			float low = previous;
+			float high = current;
+			for(int j = 0; j < sphereCastBisections; j++){
+				const float middle = (low + high) * 0.5f;
+				if(TouchesAny(world_, sphere_, bodies_, start_ + (path_ * middle))){
+					high = middle;
+				}else{
+					low = middle;
+				}
+			}
+
+			fraction_ = high;
+			return true;
+		}
+
+		return false;
+	}
+
+	//ReactPhysics capsules run along their local Y axis, this finds the transform that places one between two points
+	rp3d::Transform CapsuleTransform(const Vector3& pointA_, const Vector3& pointB_){
+		const rp3d::Vector3 a = rp3d::Vector3(pointA_.x, pointA_.y, pointA_.z);
+		const rp3d::Vector3 b = rp3d::Vector3(pointB_.x, pointB_.y, pointB_.z);
+		const rp3d::Vector3 up = rp3d::Vector3(0.0f, 1.0f, 0.0f);
+
+		rp3d::Vector3 axis = b - a;
+		if(axis.lengthSquare() < rp3d::MACHINE_EPSILON){
+			return rp3d::Transform((a + b) * 0.5f, rp3d::Quaternion::identity());
+		}
+		axis.normalize();
+
+		const rp3d::decimal dot = up.dot(axis);
+		rp3d::Quaternion rotation = rp3d::Quaternion(1.0f, 0.0f, 0.0f, 0.0f);
+		if(dot > -1.0f + rp3d::MACHINE_EPSILON){
+			rotation = rp3d::Quaternion(up.cross(axis), 1.0f + dot);
+			rotation.normalize();
+		}
+
+		return rp3d::Transform((a + b) * 0.5f, rotation);
+	}
+}
+
 Vector3 PhysicsEngine::gravity(0.0f, -100.0f, 0.0f);
 std::vector<Rigidbody*> PhysicsEngine::rbs;
 std::vector<Collider*> PhysicsEngine::cols;
 rp3d::DynamicsWorld* PhysicsEngine::world = nullptr;
 float PhysicsEngine::updatesPerSecond = 120.0f;
 float PhysicsEngine::timeAccumulator = 0.0f;
-std::vector<CollisionPair> PhysicsEngine::currentCollisions;
+int PhysicsEngine::maxSubsteps = 8;
+bool PhysicsEngine::useInterpolation = true;
+float PhysicsEngine::interpolationAlpha = 1.0f;
+bool PhysicsEngine::useThreadedStep = false;
+bool PhysicsEngine::stepPending = false;
+float PhysicsEngine::pendingDeltaTime = 0.0f;
+int PhysicsEngine::substeps = 0;
+int PhysicsEngine::droppedSteps = 0;
+std::future<void> PhysicsEngine::stepTask;
+std::unordered_map<CollisionPairKey, CollisionPair, CollisionPairKeyHash> PhysicsEngine::currentCollisions;
+std::unordered_map<CollisionPairKey, CollisionPair, CollisionPairKeyHash> PhysicsEngine::triggerOverlaps;
+bool PhysicsEngine::isBatchingUnregisters = false;
+std::unordered_set<Rigidbody*> PhysicsEngine::batchedRigidbodies;
+std::unordered_set<Collider*> PhysicsEngine::batchedColliders;
+std::unordered_set<const GameObject*> PhysicsEngine::batchedObjects;
+
+//Suppress meaningless and unavoidable warning
+#pragma warning( push )
+#pragma warning( disable : 26444 )
+RTTR_REGISTRATION{
+	rttr::registration::class_<PhysicsEngine>("PhysicsEngine")
+		.method("Raycast", &PhysicsEngine::Raycast)
+		.method("RaycastNearest", &PhysicsEngine::RaycastNearest)
+		.method("RaycastBatch", &PhysicsEngine::RaycastBatch)
+		.method("OverlapSphere", &PhysicsEngine::OverlapSphere)
+		.method("OverlapBox", &PhysicsEngine::OverlapBox)
+		.method("OverlapCapsule", &PhysicsEngine::OverlapCapsule)
+		.method("SphereCast", &PhysicsEngine::SphereCast)
+		.method("Gravity", &PhysicsEngine::Gravity)
+		.method("SetGravity", &PhysicsEngine::SetGravity);
+
+	rttr::registration::class_<RaycastInfo>("RaycastInfo")
+		.constructor()
+		.property("point", &RaycastInfo::point)
+		.property("normal", &RaycastInfo::normal)
+		.property("hitFraction", &RaycastInfo::hitFraction)
+		.property("other", &RaycastInfo::other);
+
+	rttr::registration::class_<RaycastQuery>("RaycastQuery")
+		.constructor()
+		.constructor<const Vector3&, const Vector3&, unsigned short>()
+		.property("start", &RaycastQuery::start)
+		.property("end", &RaycastQuery::end)
+		.property("layerMask", &RaycastQuery::layerMask);
+}
+#pragma warning( pop )
 
 bool PhysicsEngine::Initialize(){
 	world = new rp3d::DynamicsWorld(rp3d::Vector3(gravity.x, gravity.y, gravity.z));
@@ -24,28 +311,74 @@ bool PhysicsEngine::Initialize(){
 	world->enableSleeping(true);
 
 	timeAccumulator = 0.0f;
+	interpolationAlpha = 1.0f;
+
+	maxSubsteps = Config::GetInt("PhysicsMaxSubsteps");
+	if(maxSubsteps < 1){
+		Debug::LogWarning("PhysicsMaxSubsteps must be at least 1!", __FILE__, __LINE__);
+		maxSubsteps = 1;
+	}
+
+	useInterpolation = Config::GetBool("PhysicsInterpolation");
+	useThreadedStep = Config::GetBool("ThreadedPhysics");
+	stepPending = false;
+
+	if(CollisionLayers::Initialize() == false){
+		Debug::LogError("Collision layers could not be initialized!", __FILE__, __LINE__);
+		return false;
+	}
+
+	if(CollisionShapeCache::Initialize() == false){
+		Debug::LogError("Collision shape cache could not be initialized!", __FILE__, __LINE__);
+		return false;
+	}
 
 	return true;
 }
 
 void PhysicsEngine::Destroy(){
+	WaitForStep();
+	stepPending = false;
+
 	rbs.clear();
 	rbs.shrink_to_fit();
 
 	cols.clear();
 	cols.shrink_to_fit();
 
+	//Bodies still in the world point at the cached shapes, so the world has to go first
 	delete world;
 	world = nullptr;
 
+	CollisionShapeCache::Destroy();
+	CollisionLayers::Destroy();
+
 	currentCollisions.clear();
+	triggerOverlaps.clear();
+}
+
+void PhysicsEngine::ReserveBodies(size_t rigidbodies_, size_t colliders_){
+	if(rigidbodies_ == 0 && colliders_ == 0){
+		return;
+	}
+
+	WaitForStep();
+	rbs.reserve(rbs.size() + rigidbodies_);
+	cols.reserve(cols.size() + colliders_);
 }
 
 void PhysicsEngine::RegisterRigidbody(Rigidbody* rb_){
 	_ASSERT(rb_ != nullptr);
+	WaitForStep();
+	//Batched removals go first, otherwise a body reusing a deleted one's address would be taken out with them
+	FlushBatchedUnregisters();
 	rbs.push_back(rb_);
 
-	rb_->externalBody = world->createRigidBody(SetupTransform(rb_->GetGameObject()));
+	rb_->syncedTransform = SetupTransform(rb_->GetGameObject());
+	rb_->externalBody = world->createRigidBody(rb_->syncedTransform);
+	rb_->previousTransform = rb_->syncedTransform;
+	//Store the owning component on the body so that collisions and raycasts can find it without searching
+	rb_->externalBody->setUserData(static_cast<Component*>(rb_));
 	rb_->externalBody->enableGravity(rb_->useGravity);
 	//rb_->externalBody->setIsActive(rb_->GetEnable()); //Don't touch this or the entire physics library breaks - TODO, figure that out
 	rb_->externalBody->setMass(rb_->GetMass());
@@ -62,16 +395,21 @@ void PhysicsEngine::RegisterRigidbody(Rigidbody* rb_){
 
 void PhysicsEngine::RegisterCollider(Collider* col_){
 	_ASSERT(col_ != nullptr);
+	WaitForStep();
+	FlushBatchedUnregisters();
 	cols.push_back(col_);
 
 	if(!col_->isTrigger){
 		col_->externalBody = world->createRigidBody(SetupTransform(col_->GetGameObject()));
+		col_->externalBody->setUserData(static_cast<Component*>(col_));
 		col_->externalBody->enableGravity(false);
 		//col_->externalBody->setIsActive(true); //Don't touch this or the entire physics library breaks - TODO
 		col_->externalBody->setMass(0.0f);
 		col_->externalBody->setType(rp3d::BodyType::STATIC);
 		col_->externalBody->getMaterial().setBounciness(0.0f);
 		col_->externalBody->getMaterial().setFrictionCoefficient(0.0f);
+	}else{
+		col_->triggerShape = new rp3d::BoxShape(rp3d::Vector3(col_->scale.x / 2.0f, col_->scale.y / 2.0f, col_->scale.z / 2.0f));
 	}
 	
 	//if(col_->isTrigger){
@@ -81,48 +419,120 @@ void PhysicsEngine::RegisterCollider(Collider* col_){
 
 void PhysicsEngine::UnregisterRigidbody(Rigidbody* rb_){
 	_ASSERT(rb_ != nullptr);
-	rbs.erase(std::remove(rbs.begin(), rbs.end(), rb_), rbs.end());
+	WaitForStep();
 
 	world->destroyRigidBody(rb_->externalBody);
 	rb_->externalBody = nullptr;
 
-	for(auto& c : currentCollisions){
-		if(c.obj1 == rb_->GetGameObject() || c.obj2 == rb_->GetGameObject()){
-			c.obj1 = nullptr;
-			c.obj2 = nullptr;
-		}
+	if(isBatchingUnregisters){
+		batchedRigidbodies.insert(rb_);
+		batchedObjects.insert(rb_->GetGameObject());
+		return;
 	}
 
-	currentCollisions.erase(std::remove_if(currentCollisions.begin(), currentCollisions.end(), [](CollisionPair& cp){
-		return (cp.obj1 == nullptr) || (cp.obj2 == nullptr);
-	}), currentCollisions.end());
+	rbs.erase(std::remove(rbs.begin(), rbs.end(), rb_), rbs.end());
+	RemoveCollisionPairsWith(rb_->GetGameObject());
 }
 
 void PhysicsEngine::UnregisterCollider(Collider* col_){
 	_ASSERT(col_ != nullptr);
-	cols.erase(std::remove(cols.begin(), cols.end(), col_), cols.end());
+	WaitForStep();
 
 	if(col_->externalBody != nullptr){
 		world->destroyRigidBody(col_->externalBody);
 		col_->externalBody = nullptr;
 	}
 
-	for(auto& c : currentCollisions){
-		if(c.obj1 == col_->GetGameObject() || c.obj2 == col_->GetGameObject()){
-			c.obj1 = nullptr;
-			c.obj2 = nullptr;
-		}
+	if(col_->triggerShape != nullptr){
+		delete col_->triggerShape;
+		col_->triggerShape = nullptr;
 	}
 
-	currentCollisions.erase(std::remove_if(currentCollisions.begin(), currentCollisions.end(), [](CollisionPair& cp){
-		return (cp.obj1 == nullptr) || (cp.obj2 == nullptr);
-	}), currentCollisions.end());
+	if(isBatchingUnregisters){
+		batchedColliders.insert(col_);
+		batchedObjects.insert(col_->GetGameObject());
+		return;
+	}
+
+	cols.erase(std::remove(cols.begin(), cols.end(), col_), cols.end());
+	RemoveCollisionPairsWith(col_->GetGameObject());
+}
+
+void PhysicsEngine::BeginBatchUnregister(){
+	_ASSERT(!isBatchingUnregisters);
+	isBatchingUnregisters = true;
+}
+
+void PhysicsEngine::EndBatchUnregister(){
+	_ASSERT(isBatchingUnregisters);
+	isBatchingUnregisters = false;
+	FlushBatchedUnregisters();
+}
+
+void PhysicsEngine::FlushBatchedUnregisters(){
+	if(!batchedRigidbodies.empty()){
+		rbs.erase(std::remove_if(rbs.begin(), rbs.end(), [](Rigidbody* rb_){ return batchedRigidbodies.find(rb_) != batchedRigidbodies.end(); }), rbs.end());
+		batchedRigidbodies.clear();
+	}
+
+	if(!batchedColliders.empty()){
+		cols.erase(std::remove_if(cols.begin(), cols.end(), [](Collider* col_){ return batchedColliders.find(col_) != batchedColliders.end(); }), cols.end());
+		batchedColliders.clear();
+	}
+
+	if(!batchedObjects.empty()){
+		RemoveCollisionPairsWith(batchedObjects);
+		batchedObjects.clear();
+	}
 }
 
 void PhysicsEngine::Update(const float deltaTime_){
 	//Make sure that deltaTime is positive
 	_ASSERT(deltaTime_ >= 0.0f);
 
+	if(useThreadedStep){
+		//The step itself is started by StartStep once game logic is done, so it can run alongside rendering
+		pendingDeltaTime = deltaTime_;
+		return;
+	}
+
+	PushState();
+	Simulate(deltaTime_);
+	Publish(deltaTime_);
+}
+
+void PhysicsEngine::SetThreadedStep(bool threaded_){
+	//This assertion will trigger if this is called between StartStep and FinishStep
+	_ASSERT(!stepPending);
+	useThreadedStep = threaded_;
+}
+
+void PhysicsEngine::StartStep(){
+	if(!useThreadedStep){
+		return;
+	}
+
+	_ASSERT(!stepPending);
+
+	//Everything the step needs from the scene is pushed into ReactPhysics here, on the main thread
+	//From now until FinishStep the worker only touches the physics world, so the scene's transforms stay safe to render
+	PushState();
+	stepTask = std::async(std::launch::async, &PhysicsEngine::Simulate, pendingDeltaTime);
+	stepPending = true;
+}
+
+void PhysicsEngine::FinishStep(){
+	if(!stepPending){
+		return;
+	}
+
+	WaitForStep();
+	stepPending = false;
+
+	Publish(pendingDeltaTime);
+}
+
+void PhysicsEngine::PushState(){
 	for(Rigidbody* rb : rbs){
 		rb->PreUpdate();
 	}
@@ -130,114 +540,238 @@ void PhysicsEngine::Update(const float deltaTime_){
 	for(Collider* col : cols){
 		col->PreUpdate();
 	}
+}
 
+void PhysicsEngine::Simulate(float deltaTime_){
+	//This may run on a worker thread, so nothing in here may touch the scene or any other engine system
+	const float timeStep = 1.0f / updatesPerSecond;
+
+	//Drop any time beyond what we're allowed to simulate this frame, otherwise one long frame makes the next one even longer
 	timeAccumulator += deltaTime_;
-	while(timeAccumulator >= 1.0f / updatesPerSecond){
-		world->update(1.0f / updatesPerSecond);
-		timeAccumulator -= 1.0f / updatesPerSecond;
+	droppedSteps = 0;
+	if(timeAccumulator > timeStep * maxSubsteps){
+		droppedSteps = static_cast<int>(timeAccumulator / timeStep) - maxSubsteps;
+		timeAccumulator = timeStep * maxSubsteps;
 	}
 
-	for(Rigidbody* rb : rbs){
-		rb->Update(deltaTime_);
+	substeps = 0;
+	while(timeAccumulator >= timeStep && substeps < maxSubsteps){
+		for(Rigidbody* rb : rbs){
+			rb->previousTransform = rb->externalBody->getTransform();
+		}
+
+		world->update(timeStep);
+		timeAccumulator -= timeStep;
+		substeps++;
 	}
 
-	//We haven't checked any collision pairs this frame so set everything to 
-	for(auto& c : currentCollisions){
-		c.checkedThisFrame = false;
+	if(useInterpolation){
+		interpolationAlpha = Math::Clamp(0.0f, 1.0f, timeAccumulator / timeStep);
+	}else{
+		interpolationAlpha = 1.0f;
 	}
+}
 
-	for(const auto& collisions : world->getContactsList()){
-		auto b1 = collisions->getBody1();
-		auto b2 = collisions->getBody2();
+void PhysicsEngine::Publish(float deltaTime_){
+	EngineStats::SetInt("Physics Substeps", substeps);
+	EngineStats::AddToInt("Physics Dropped Steps", droppedSteps);
 
-		GameObject* go1 = nullptr;
-		GameObject* go2 = nullptr;
+	int awakeBodies = 0;
+	int sleepingBodies = 0;
 
-		for(Rigidbody* rb : rbs){
-			if(rb->externalBody == b1){
-				go1 = rb->GetGameObject();
-			}else if(rb->externalBody == b2){
-				go2 = rb->GetGameObject();
-			}
+	for(Rigidbody* rb : rbs){
+		rb->Update(deltaTime_);
 
-			if(go1 && go2){
-				break;
-			}
+		if(rb->externalBody->getType() != rp3d::BodyType::DYNAMIC){
+			continue;
 		}
 
-		for(Collider* col : cols){
-			if(col->externalBody == b1){
-				go1 = col->GetGameObject();
-			}else if(col->externalBody == b2){
-				go2 = col->GetGameObject();
-			}
-
-			if(go1 && go2){
-				break;
-			}
+		if(rb->externalBody->isSleeping()){
+			sleepingBodies++;
+		}else{
+			awakeBodies++;
 		}
+	}
+
+	EngineStats::SetInt("Awake Rigidbodies", awakeBodies);
+	EngineStats::SetInt("Sleeping Rigidbodies", sleepingBodies);
+
+	Debug::StartProfiling("Physics Collision Events");
+
+	//We haven't checked any collision pairs this frame so set everything to false
+	for(auto& c : currentCollisions){
+		c.second.checkedThisFrame = false;
+	}
+
+	int contactManifolds = 0;
+	int skippedEvents = 0;
+
+	for(const auto& collisions : world->getContactsList()){
+		contactManifolds++;
+
+		const Component* c1 = static_cast<const Component*>(collisions->getBody1()->getUserData());
+		const Component* c2 = static_cast<const Component*>(collisions->getBody2()->getUserData());
 
-		if(go1 == nullptr || go2 == nullptr){
+		if(c1 == nullptr || c2 == nullptr){
 			Debug::LogError("Unregistered components are somehow colliding!", __FILE__, __LINE__);
 			continue;
 		}
 
-		bool foundCollision = false;
-		for(auto& v : currentCollisions){
-			if(v == CollisionPair(go1, go2)){
-				//This collision is still happening
-				foundCollision = true;
-				UpdateCollisionPair(go1, go2, collisions);
-			}
+		//Layers that opted out of events still collide, they just never reach any scripts
+		const int layer1 = CollisionLayers::LayerFromCategoryBits(collisions->getShape1()->getCollisionCategoryBits());
+		const int layer2 = CollisionLayers::LayerFromCategoryBits(collisions->getShape2()->getCollisionCategoryBits());
+		if(!CollisionLayers::EventsEnabled(layer1) || !CollisionLayers::EventsEnabled(layer2)){
+			skippedEvents++;
+			continue;
 		}
 
-		if(!foundCollision){
+		GameObject* go1 = c1->GetGameObject();
+		GameObject* go2 = c2->GetGameObject();
+
+		auto pair = currentCollisions.find(CollisionPairKey(go1, go2));
+		if(pair == currentCollisions.end()){
 			AddCollisionPair(go1, go2, collisions);
+		}else if(!pair->second.checkedThisFrame){
+			//This collision is still happening
+			UpdateCollisionPair(pair->second, collisions);
 		}
 	}
 
-	for(const auto& c : currentCollisions){
-		if(!c.checkedThisFrame){
-			RemoveCollisionPair(c.obj1, c.obj2);
+	for(auto c = currentCollisions.begin(); c != currentCollisions.end();){
+		if(!c->second.checkedThisFrame){
+			GameObject* go1 = c->second.obj1;
+			GameObject* go2 = c->second.obj2;
+			c = currentCollisions.erase(c);
+			RemoveCollisionPair(go1, go2);
+		}else{
+			++c;
 		}
 	}
+
+	EngineStats::SetInt("Contact Manifolds", contactManifolds);
+	EngineStats::SetInt("Filtered Collision Events", skippedEvents);
+
+	UpdateTriggers();
+
+	Debug::EndProfiling("Physics Collision Events");
 }
 
-std::vector<RaycastInfo> PhysicsEngine::Raycast(const Vector3& start_, const Vector3& end_){
-	std::vector<RaycastInfo> infos;
+std::vector<RaycastInfo> PhysicsEngine::Raycast(const Vector3& start_, const Vector3& end_, unsigned short layerMask_){
+	WaitForStep();
 
-	rp3d::Ray ray = rp3d::Ray(rp3d::Vector3(start_.x, start_.y, start_.z), rp3d::Vector3(end_.x, end_.y, end_.z));
-	rp3d::RaycastInfo in;
+	//Let the world's broadphase find the bodies along the ray instead of testing every body ourselves
+	AllHitsCallback callback;
+	world->raycast(ToRay(start_, end_), &callback, layerMask_);
 
-	for(Rigidbody* rb : rbs){
-		if(!rb->GetEnable()){
-			continue;
-		}
+	return callback.hits;
+}
+
+bool PhysicsEngine::RaycastNearest(const Vector3& start_, const Vector3& end_, RaycastInfo& hit_, unsigned short layerMask_){
+	WaitForStep();
+
+	NearestHitCallback callback;
+	world->raycast(ToRay(start_, end_), &callback, layerMask_);
+
+	if(callback.hasHit){
+		hit_ = callback.hit;
+	}
 
-		if(rb->externalBody->raycast(ray, in)){
-			infos.push_back(PizzaBox::RaycastInfo(
-				Vector3(in.worldPoint.x, in.worldPoint.y, in.worldPoint.z),
-				Vector3(in.worldNormal.x, in.worldNormal.y, in.worldNormal.z),
-				in.hitFraction, rb->GetGameObject()
-			));
+	return callback.hasHit;
+}
+
+std::vector<RaycastInfo> PhysicsEngine::RaycastBatch(const std::vector<RaycastQuery>& queries_){
+	WaitForStep();
+
+	//Results line up with the queries, a result with no other object means that ray didn't hit anything
+	//ReactPhysics raycasts against some shapes allocate from the world's memory allocator, so these run one after another
+	std::vector<RaycastInfo> results = std::vector<RaycastInfo>(queries_.size());
+
+	for(size_t i = 0; i < queries_.size(); i++){
+		NearestHitCallback callback;
+		world->raycast(ToRay(queries_[i].start, queries_[i].end), &callback, queries_[i].layerMask);
+
+		if(callback.hasHit){
+			results[i] = callback.hit;
 		}
 	}
 
-	for(Collider* col : cols){
-		if(!col->GetEnable()){
+	return results;
+}
+
+std::vector<GameObject*> PhysicsEngine::OverlapSphere(const Vector3& center_, float radius_, unsigned short layerMask_){
+	rp3d::SphereShape shape(radius_);
+	return Overlap(&shape, rp3d::Transform(rp3d::Vector3(center_.x, center_.y, center_.z), rp3d::Quaternion::identity()), layerMask_);
+}
+
+std::vector<GameObject*> PhysicsEngine::OverlapBox(const Vector3& center_, const Vector3& halfExtents_, const Quaternion& rotation_, unsigned short layerMask_){
+	rp3d::BoxShape shape(rp3d::Vector3(halfExtents_.x, halfExtents_.y, halfExtents_.z));
+	rp3d::Transform transform = rp3d::Transform(rp3d::Vector3(center_.x, center_.y, center_.z), rp3d::Quaternion(rotation_.x, rotation_.y, rotation_.z, rotation_.w));
+	return Overlap(&shape, transform, layerMask_);
+}
+
+std::vector<GameObject*> PhysicsEngine::OverlapCapsule(const Vector3& pointA_, const Vector3& pointB_, float radius_, unsigned short layerMask_){
+	rp3d::CapsuleShape shape(radius_, Vector3::Distance(pointA_, pointB_));
+	return Overlap(&shape, CapsuleTransform(pointA_, pointB_), layerMask_);
+}
+
+std::vector<RaycastInfo> PhysicsEngine::SphereCast(const Vector3& start_, const Vector3& end_, float radius_, unsigned short layerMask_){
+	//A sphere with no size is just a ray
+	if(radius_ <= 0.0f){
+		std::vector<RaycastInfo> hits = Raycast(start_, end_, layerMask_);
+		std::sort(hits.begin(), hits.end(), [](const RaycastInfo& a_, const RaycastInfo& b_){ return a_.hitFraction < b_.hitFraction; });
+		return hits;
+	}
+
+	WaitForStep();
+
+	//ReactPhysics can't sweep shapes, so the bodies inside the volume the sphere passes through are found first
+	rp3d::CapsuleShape pathShape(radius_, Vector3::Distance(start_, end_));
+	rp3d::CollisionBody* pathBody = world->createCollisionBody(CapsuleTransform(start_, end_));
+	pathBody->addCollisionShape(&pathShape, rp3d::Transform::identity());
+
+	CandidateBodyCallback candidates;
+	world->testOverlap(pathBody, &candidates, layerMask_);
+	world->destroyCollisionBody(pathBody);
+
+	//Then a sphere is moved along the path to find where it first touches each of them
+	const rp3d::Vector3 start = rp3d::Vector3(start_.x, start_.y, start_.z);
+	const rp3d::Vector3 path = rp3d::Vector3(end_.x, end_.y, end_.z) - start;
+
+	rp3d::SphereShape sphereShape(radius_);
+	rp3d::CollisionBody* sphereBody = world->createCollisionBody(rp3d::Transform(start, rp3d::Quaternion::identity()));
+	sphereBody->addCollisionShape(&sphereShape, rp3d::Transform::identity());
+
+	std::vector<RaycastInfo> hits;
+	for(const auto& candidate : candidates.results){
+		float fraction = 0.0f;
+		if(!SphereTimeOfImpact(world, sphereBody, candidate.second, start, path, radius_, fraction)){
 			continue;
 		}
 
-		if(col->externalBody->raycast(ray, in)){
-			infos.push_back(PizzaBox::RaycastInfo(
-				Vector3(in.worldPoint.x, in.worldPoint.y, in.worldPoint.z),
-				Vector3(in.worldNormal.x, in.worldNormal.y, in.worldNormal.z),
-				in.hitFraction, col->GetGameObject()
-			));
+		const rp3d::Vector3 center = start + (path * fraction);
+		sphereBody->setTransform(rp3d::Transform(center, rp3d::Quaternion::identity()));
+
+		//The sphere is only just touching here, so the hit point sits one radius away from its center along the surface normal
+		SphereCastContactCallback contact(sphereBody);
+		for(rp3d::CollisionBody* body : candidate.second){
+			if(!contact.hasContact){
+				world->testCollision(sphereBody, body, &contact);
+			}
+		}
+
+		rp3d::Vector3 normal = contact.hasContact ? contact.normal : -path;
+		if(normal.lengthSquare() > rp3d::MACHINE_EPSILON){
+			normal.normalize();
 		}
+
+		const rp3d::Vector3 point = center - (normal * radius_);
+		hits.push_back(RaycastInfo(Vector3(point.x, point.y, point.z), Vector3(normal.x, normal.y, normal.z), fraction, candidate.first));
 	}
 
-	return infos;
+	world->destroyCollisionBody(sphereBody);
+
+	std::sort(hits.begin(), hits.end(), [](const RaycastInfo& a_, const RaycastInfo& b_){ return a_.hitFraction < b_.hitFraction; });
+	return hits;
 }
 
 void PhysicsEngine::SetGravity(const Vector3& vec){
@@ -257,85 +791,165 @@ rp3d::Transform PhysicsEngine::SetupTransform(const GameObject* go_){
 
 void PhysicsEngine::AddCollisionPair(GameObject* go1_, GameObject* go2_, const rp3d::ContactManifold* contactInfo_){
 	CollisionPair pair = CollisionPair(go1_, go2_);
+	pair.checkedThisFrame = true;
+
+	Vector3 normal = GetContactNormal(contactInfo_);
+	pair.contactNormal = normal;
+
+	if(currentCollisions.insert(std::make_pair(CollisionPairKey(go1_, go2_), pair)).second == false){
+		//We already know about this collision
+		return;
+	}
 
-	for(const auto& cp : currentCollisions){
-		if(cp == pair){
-			return;
+	ScriptManager::QueueCollisionEvent(go1_, CollisionEventType::Enter, CollisionInfo(go2_, normal));
+	ScriptManager::QueueCollisionEvent(go2_, CollisionEventType::Enter, CollisionInfo(go1_, normal));
+}
+
+void PhysicsEngine::UpdateCollisionPair(CollisionPair& pair_, const rp3d::ContactManifold* contactInfo_){
+	pair_.checkedThisFrame = true;
+
+	Vector3 normal = GetContactNormal(contactInfo_);
+	pair_.contactNormal = normal;
+
+	ScriptManager::QueueCollisionEvent(pair_.obj1, CollisionEventType::Stay, CollisionInfo(pair_.obj2, normal));
+	ScriptManager::QueueCollisionEvent(pair_.obj2, CollisionEventType::Stay, CollisionInfo(pair_.obj1, normal));
+}
+
+void PhysicsEngine::RemoveCollisionPair(GameObject* go1_, GameObject* go2_){
+	//The pair has already been taken out of currentCollisions, all that's left is to let the scripts know
+	ScriptManager::QueueCollisionEvent(go1_, CollisionEventType::Exit, CollisionInfo(go2_, Vector3::Zero()));
+	ScriptManager::QueueCollisionEvent(go2_, CollisionEventType::Exit, CollisionInfo(go1_, Vector3::Zero()));
+}
+
+void PhysicsEngine::RemoveCollisionPairsWith(const std::unordered_set<const GameObject*>& objects_){
+	const auto isRemoved = [&objects_](const CollisionPair& pair_){
+		return objects_.find(pair_.obj1) != objects_.end() || objects_.find(pair_.obj2) != objects_.end();
+	};
+
+	for(auto c = currentCollisions.begin(); c != currentCollisions.end();){
+		if(isRemoved(c->second)){
+			c = currentCollisions.erase(c);
+		}else{
+			++c;
 		}
 	}
 
-	pair.checkedThisFrame = true;
-	currentCollisions.push_back(pair);
+	for(auto t = triggerOverlaps.begin(); t != triggerOverlaps.end();){
+		if(isRemoved(t->second)){
+			t = triggerOverlaps.erase(t);
+		}else{
+			++t;
+		}
+	}
+}
 
-	Vector3 normal = Vector3::Zero();
+void PhysicsEngine::RemoveCollisionPairsWith(const GameObject* go_){
+	for(auto c = currentCollisions.begin(); c != currentCollisions.end();){
+		if(c->second.obj1 == go_ || c->second.obj2 == go_){
+			c = currentCollisions.erase(c);
+		}else{
+			++c;
+		}
+	}
+
+	for(auto t = triggerOverlaps.begin(); t != triggerOverlaps.end();){
+		if(t->second.obj1 == go_ || t->second.obj2 == go_){
+			t = triggerOverlaps.erase(t);
+		}else{
+			++t;
+		}
+	}
+}
 
+Vector3 PhysicsEngine::GetContactNormal(const rp3d::ContactManifold* contactInfo_){
 	auto contactPoint = contactInfo_->getContactPoints();
 	if(contactPoint != nullptr){
 		auto rp3dNormal = contactPoint->getNormal();
-		normal = Vector3(rp3dNormal.x, rp3dNormal.y, rp3dNormal.z);
+		return Vector3(rp3dNormal.x, rp3dNormal.y, rp3dNormal.z);
 	}
 
-	auto scripts = go1_->GetComponents<Script>();
-	for(Script* s : scripts){
-		s->RegisterCollisionEnter(CollisionInfo(go2_, normal));
-	}
+	return Vector3::Zero();
+}
 
-	scripts = go2_->GetComponents<Script>();
-	for(Script* s : scripts){
-		s->RegisterCollisionEnter(CollisionInfo(go1_, normal));
+void PhysicsEngine::UpdateTriggers(){
+	//Triggers aren't part of the simulation at all, each one just asks the broadphase which bodies' bounds overlap its own
+	//That way they never generate contacts or cost the solver anything
+	for(auto& t : triggerOverlaps){
+		t.second.checkedThisFrame = false;
 	}
-}
 
-void PhysicsEngine::UpdateCollisionPair(GameObject* go1_, GameObject* go2_, const rp3d::ContactManifold* contactInfo_){
-	CollisionPair pair = CollisionPair(go1_, go2_);
+	for(Collider* col : cols){
+		if(col->triggerShape == nullptr || !col->GetEnable() || !CollisionLayers::EventsEnabled(col->layer)){
+			continue;
+		}
 
-	for(auto& cp : currentCollisions){
-		if(cp == pair){
-			cp.checkedThisFrame = true;
+		GameObject* triggerObject = col->GetGameObject();
 
-			Vector3 normal = Vector3::Zero();
+		TriggerOverlapCallback callback = TriggerOverlapCallback(triggerObject);
+		world->testAABBOverlap(TriggerBounds(col), &callback, CollisionLayers::CollideWithBits(col->layer));
 
-			auto contactPoint = contactInfo_->getContactPoints();
-			if(contactPoint != nullptr){
-				auto rp3dNormal = contactPoint->getNormal();
-				normal = Vector3(rp3dNormal.x, rp3dNormal.y, rp3dNormal.z);
+		for(GameObject* other : callback.results){
+			auto overlap = triggerOverlaps.find(CollisionPairKey(triggerObject, other));
+			if(overlap != triggerOverlaps.end()){
+				overlap->second.checkedThisFrame = true;
+				continue;
 			}
 
-			auto scripts = go1_->GetComponents<Script>();
-			for(Script* s : scripts){
-				s->RegisterCollisionStay(CollisionInfo(go2_, normal));
-			}
+			CollisionPair pair = CollisionPair(triggerObject, other);
+			pair.checkedThisFrame = true;
+			triggerOverlaps.insert(std::make_pair(CollisionPairKey(triggerObject, other), pair));
+			RegisterTriggerEvent(triggerObject, other, true);
+		}
+	}
 
-			scripts = go2_->GetComponents<Script>();
-			for(Script* s : scripts){
-				s->RegisterCollisionStay(CollisionInfo(go1_, normal));
-			}
+	for(auto t = triggerOverlaps.begin(); t != triggerOverlaps.end();){
+		if(!t->second.checkedThisFrame){
+			GameObject* go1 = t->second.obj1;
+			GameObject* go2 = t->second.obj2;
+			t = triggerOverlaps.erase(t);
+			RegisterTriggerEvent(go1, go2, false);
+		}else{
+			++t;
 		}
 	}
+
+	EngineStats::SetInt("Trigger Overlaps", static_cast<long long>(triggerOverlaps.size()));
 }
 
-void PhysicsEngine::RemoveCollisionPair(GameObject* go1_, GameObject* go2_){
-	CollisionPair pair = CollisionPair(go1_, go2_);
-	bool handleCollisionExit = false;
+rp3d::AABB PhysicsEngine::TriggerBounds(const Collider* trigger_){
+	_ASSERT(trigger_->triggerShape != nullptr);
 
-	for(const auto& cp : currentCollisions){
-		if(cp == pair){
-			handleCollisionExit = true;
-			break;
-		}
-	}
+	const rp3d::Transform offset = rp3d::Transform(rp3d::Vector3(trigger_->offset.x, trigger_->offset.y, trigger_->offset.z), rp3d::Quaternion::identity());
 
-	currentCollisions.erase(std::remove(currentCollisions.begin(), currentCollisions.end(), pair), currentCollisions.end());
+	//Let the shape work out its own world bounds, the same way the broadphase does for bodies
+	rp3d::AABB bounds;
+	trigger_->triggerShape->computeAABB(bounds, SetupTransform(trigger_->GetGameObject()) * offset);
+	return bounds;
+}
 
-	if(handleCollisionExit){
-		auto scripts = go1_->GetComponents<Script>();
-		for(Script* s : scripts){
-			s->RegisterCollisionExit(go2_);
-		}
+void PhysicsEngine::RegisterTriggerEvent(GameObject* go1_, GameObject* go2_, bool entered_){
+	const CollisionEventType type = entered_ ? CollisionEventType::Enter : CollisionEventType::Exit;
+	ScriptManager::QueueCollisionEvent(go1_, type, CollisionInfo(go2_, Vector3::Zero(), true));
+	ScriptManager::QueueCollisionEvent(go2_, type, CollisionInfo(go1_, Vector3::Zero(), true));
+}
 
-		scripts = go2_->GetComponents<Script>();
-		for(Script* s : scripts){
-			s->RegisterCollisionExit(go1_);
-		}
+std::vector<GameObject*> PhysicsEngine::Overlap(rp3d::CollisionShape* shape_, const rp3d::Transform& transform_, unsigned short layerMask_){
+	WaitForStep();
+
+	//A short-lived body lets the world's broadphase tree narrow down what to test against the shape
+	//It's removed again before the next world update so it never takes part in the simulation
+	rp3d::CollisionBody* queryBody = world->createCollisionBody(transform_);
+	queryBody->addCollisionShape(shape_, rp3d::Transform::identity());
+
+	OverlapResultCallback callback;
+	world->testOverlap(queryBody, &callback, layerMask_);
+
+	world->destroyCollisionBody(queryBody);
+	return callback.results;
+}
+
+void PhysicsEngine::WaitForStep(){
+	if(stepTask.valid()){
+		stepTask.get();
 	}
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #ifndef PHYSICS_ENGINE_H
 #define PHYSICS_ENGINE_H
 
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <reactphysics3d.h>
 
 #include "Collider.h"
@@ -28,6 +33,26 @@ namespace PizzaBox{
 		bool checkedThisFrame;
 	};
 
+	//Identifies a pair of colliding objects regardless of which order the bodies were reported in
+	struct CollisionPairKey{
+		CollisionPairKey(const GameObject* go1_, const GameObject* go2_) : first(std::less<const GameObject*>()(go1_, go2_) ? go1_ : go2_), second(std::less<const GameObject*>()(go1_, go2_) ? go2_ : go1_){}
+
+		inline bool operator ==(const CollisionPairKey& rhs_) const{
+			return (first == rhs_.first && second == rhs_.second);
+		}
+
+		const GameObject* first;
+		const GameObject* second;
+	};
+
+	struct CollisionPairKeyHash{
+		inline size_t operator()(const CollisionPairKey& key_) const{
+			const size_t h1 = std::hash<const GameObject*>()(key_.first);
+			const size_t h2 = std::hash<const GameObject*>()(key_.second);
+			return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+		}
+	};
+
 	struct RaycastInfo{
 		RaycastInfo(const Vector3& point_ = Vector3(), const Vector3& normal_ = Vector3(), float hitFraction_ = 0.0f, GameObject* other_ = nullptr) : point(point_), normal(normal_), hitFraction(hitFraction_), other(other_){}
 
@@ -37,6 +62,14 @@ namespace PizzaBox{
 		GameObject* other;
 	};
 
+	struct RaycastQuery{
+		RaycastQuery(const Vector3& start_ = Vector3(), const Vector3& end_ = Vector3(), unsigned short layerMask_ = 0xFFFF) : start(start_), end(end_), layerMask(layerMask_){}
+
+		Vector3 start;
+		Vector3 end;
+		unsigned short layerMask;
+	};
+
 	class PhysicsEngine{
 	public:
 		static bool Initialize();
@@ -44,14 +77,36 @@ namespace PizzaBox{
 
 		static void RegisterRigidbody(Rigidbody* rb_);
 		static void RegisterCollider(Collider* col_);
+		//Makes room for a batch of bodies up front, waiting on the step once instead of for each one
+		static void ReserveBodies(size_t rigidbodies_, size_t colliders_);
 
 		static void UnregisterRigidbody(Rigidbody* rb_);
 		static void UnregisterCollider(Collider* col_);
+		//Bodies unregistered between these two calls are all taken out of the lists and collision pairs in one pass, for destroying objects in bulk
+		static void BeginBatchUnregister();
+		static void EndBatchUnregister();
 		
 		static void Update(float deltaTime_);
-		static std::vector<RaycastInfo> Raycast(const Vector3& start_, const Vector3& end_);
+		//When ThreadedPhysics is on, the step runs on a worker thread between these two calls
+		static void StartStep();
+		static void FinishStep();
+		static std::vector<RaycastInfo> Raycast(const Vector3& start_, const Vector3& end_, unsigned short layerMask_ = 0xFFFF);
+		static bool RaycastNearest(const Vector3& start_, const Vector3& end_, RaycastInfo& hit_, unsigned short layerMask_ = 0xFFFF);
+		static std::vector<RaycastInfo> RaycastBatch(const std::vector<RaycastQuery>& queries_);
+
+		static std::vector<GameObject*> OverlapSphere(const Vector3& center_, float radius_, unsigned short layerMask_ = 0xFFFF);
+		static std::vector<GameObject*> OverlapBox(const Vector3& center_, const Vector3& halfExtents_, const Quaternion& rotation_, unsigned short layerMask_ = 0xFFFF);
+		static std::vector<GameObject*> OverlapCapsule(const Vector3& pointA_, const Vector3& pointB_, float radius_, unsigned short layerMask_ = 0xFFFF);
+		//Sweeps a sphere from start to end, results are sorted by how far along the path each object was reached
+		static std::vector<RaycastInfo> SphereCast(const Vector3& start_, const Vector3& end_, float radius_, unsigned short layerMask_ = 0xFFFF);
+
+		//Only safe between frames, while no step is in flight
+		static void SetThreadedStep(bool threaded_);
+		static bool IsThreadedStep(){ return useThreadedStep; }
 
 		static Vector3 Gravity(){ return gravity; }
+		//How far between the last two physics steps the current frame is, from 0 to 1
+		static float InterpolationAlpha(){ return interpolationAlpha; }
 		static void SetGravity(const Vector3& vec);
 		static rp3d::Transform SetupTransform(const GameObject* go_);
 
@@ -70,12 +125,39 @@ namespace PizzaBox{
 		static rp3d::DynamicsWorld* world;
 		static float updatesPerSecond;
 		static float timeAccumulator;
-
-		static std::vector<CollisionPair> currentCollisions;
+		static int maxSubsteps;
+		static bool useInterpolation;
+		static float interpolationAlpha;
+		static bool useThreadedStep;
+		static bool stepPending;
+		static float pendingDeltaTime;
+		static int substeps;
+		static int droppedSteps;
+		static std::future<void> stepTask;
+
+		static std::unordered_map<CollisionPairKey, CollisionPair, CollisionPairKeyHash> currentCollisions;
+		static std::unordered_map<CollisionPairKey, CollisionPair, CollisionPairKeyHash> triggerOverlaps;
+
+		static bool isBatchingUnregisters;
+		static std::unordered_set<Rigidbody*> batchedRigidbodies;
+		static std::unordered_set<Collider*> batchedColliders;
+		static std::unordered_set<const GameObject*> batchedObjects; //Kept separately since the components are deleted before the batch ends
 
 		static void AddCollisionPair(GameObject* go1_, GameObject* go2_, const rp3d::ContactManifold* contactInfo_);
-		static void UpdateCollisionPair(GameObject* go1_, GameObject* go2_, const rp3d::ContactManifold* contactInfo_);
+		static void UpdateCollisionPair(CollisionPair& pair_, const rp3d::ContactManifold* contactInfo_);
 		static void RemoveCollisionPair(GameObject* go1_, GameObject* go2_);
+		static void RemoveCollisionPairsWith(const GameObject* go_);
+		static void RemoveCollisionPairsWith(const std::unordered_set<const GameObject*>& objects_);
+		static void FlushBatchedUnregisters();
+		static Vector3 GetContactNormal(const rp3d::ContactManifold* contactInfo_);
+		static void UpdateTriggers();
+		static rp3d::AABB TriggerBounds(const Collider* trigger_);
+		static void RegisterTriggerEvent(GameObject* go1_, GameObject* go2_, bool entered_);
+		static void PushState();
+		static void Simulate(float deltaTime_);
+		static void Publish(float deltaTime_);
+		static void WaitForStep();
+		static std::vector<GameObject*> Overlap(rp3d::CollisionShape* shape_, const rp3d::Transform& transform_, unsigned short layerMask_);
 	};
 }
 
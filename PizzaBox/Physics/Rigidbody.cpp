@@ -2,6 +2,7 @@
 
 #include <rttr/registration.h>
 
+#include "CollisionLayers.h"
 #include "PhysicsEngine.h"
 #include "Math/Euler.h"
 #include "Script/Script.h"
@@ -51,11 +52,13 @@ RTTR_REGISTRATION{
 		.method("SetMaxLinearVelocity", static_cast<void(Rigidbody::*)(float)>(&Rigidbody::SetMaxLinearVelocity))
 		.method("SetLinearVelocityLimits", static_cast<void(Rigidbody::*)(const Vector3&, const Vector3&)>(&Rigidbody::SetLinearVelocityLimits))
 		.method("SetLinearVelocityLimits", static_cast<void(Rigidbody::*)(float, float)>(&Rigidbody::SetLinearVelocityLimits))
-		.method("SetLinearVelocityDamping", &Rigidbody::SetLinearVelocityDamping);
+		.method("SetLinearVelocityDamping", &Rigidbody::SetLinearVelocityDamping)
+		.method("GetLayer", &Rigidbody::GetLayer)
+		.method("SetLayer", &Rigidbody::SetLayer);
 }
 #pragma warning( pop )
 
-Rigidbody::Rigidbody(float mass_, bool useGravity_, bool freezeRotation_) : Component(), mass(mass_), useGravity(useGravity_), externalBody(nullptr), freezeRotation(freezeRotation_), material(0.5f, 0.5f), dampingValue(0.0f){
+Rigidbody::Rigidbody(float mass_, bool useGravity_, bool freezeRotation_) : Component(), mass(mass_), useGravity(useGravity_), externalBody(nullptr), freezeRotation(freezeRotation_), material(0.5f, 0.5f), dampingValue(0.0f), layer(CollisionLayers::defaultLayer){
 	//Make sure that mass is positive
 	_ASSERT(mass >= 0.0f);
 
@@ -81,15 +84,17 @@ bool Rigidbody::Initialize(GameObject* go_){
 }
 
 void Rigidbody::Destroy(){
-	std::vector<rp3d::ProxyShape*> shapes;
-	auto proxShape = externalBody->getProxyShapesList();
-	while(proxShape != nullptr){
-		shapes.push_back(proxShape);
-		proxShape = proxShape->getNext();
-	}
+	if(externalBody != nullptr){
+		std::vector<rp3d::ProxyShape*> shapes;
+		auto proxShape = externalBody->getProxyShapesList();
+		while(proxShape != nullptr){
+			shapes.push_back(proxShape);
+			proxShape = proxShape->getNext();
+		}
 
-	for(const auto& ps : shapes){
-		externalBody->removeCollisionShape(ps);
+		for(const auto& ps : shapes){
+			externalBody->removeCollisionShape(ps);
+		}
 	}
 
 	for(rp3d::CollisionShape* shape : colliders){
@@ -107,23 +112,57 @@ void Rigidbody::Destroy(){
 
 	colliderData.clear();
 	colliderData.shrink_to_fit();
+	colliderOffsets.clear();
+	colliderOffsets.shrink_to_fit();
 
 	while(!colliderAddQueue.empty()){
 		BaseCollider* data = colliderAddQueue.front();
 		colliderAddQueue.pop();
+		colliderOffsetQueue.pop();
 		delete data;
 		data = nullptr;
 	}
 
-	PhysicsEngine::UnregisterRigidbody(this);
+	//Copies held by prefabs were never registered
+	if(gameObject != nullptr){
+		PhysicsEngine::UnregisterRigidbody(this);
+	}
+
 	gameObject = nullptr;
 }
 
+Component* Rigidbody::Clone() const{
+	//The copy starts at rest, with no body until it's initialized
+	Rigidbody* clone = new Rigidbody(mass, useGravity, freezeRotation);
+	clone->SetEnable(GetEnable());
+	clone->material = material;
+	clone->minLinearVelocity = minLinearVelocity;
+	clone->maxLinearVelocity = maxLinearVelocity;
+	clone->dampingValue = dampingValue;
+	clone->layer = layer;
+
+	for(size_t i = 0; i < colliderData.size(); i++){
+		clone->AddCollider(colliderData[i]->Clone(), colliderOffsets[i]);
+	}
+
+	//Colliders that haven't been added to the body yet come along too
+	std::queue<BaseCollider*> pending = colliderAddQueue;
+	std::queue<Vector3> pendingOffsets = colliderOffsetQueue;
+	while(!pending.empty()){
+		clone->AddCollider(pending.front()->Clone(), pendingOffsets.front());
+		pending.pop();
+		pendingOffsets.pop();
+	}
+
+	return clone;
+}
+
 void Rigidbody::PreUpdate(){
 	while(!colliderAddQueue.empty()){
 		BaseCollider* col = colliderAddQueue.front();
 		colliderData.push_back(col);
 		Vector3 offset = colliderOffsetQueue.front();
+		colliderOffsets.push_back(offset);
 
 		rp3d::Vector3 rpOffset(offset.x, offset.y, offset.z);
 
@@ -136,31 +175,31 @@ void Rigidbody::PreUpdate(){
 			case BaseCollider::Shape::Box:
 				scale = static_cast<BoxCollider*>(col)->scale / 2.0f;
 				shape = new rp3d::BoxShape(rp3d::Vector3(scale.x, scale.y, scale.z));
-				externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass);
+				ApplyLayer(externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass));
 				colliders.push_back(shape);
 				break;
 			case BaseCollider::Shape::Sphere:
 				radius = static_cast<SphereCollider*>(col)->radius;
 				shape = new rp3d::SphereShape(radius);
-				externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass);
+				ApplyLayer(externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass));
 				colliders.push_back(shape);
 				break;
 			case BaseCollider::Shape::Capsule:
 				radius = static_cast<CapsuleCollider*>(col)->radius;
 				height = static_cast<CapsuleCollider*>(col)->height;
 				shape = new rp3d::CapsuleShape(radius, height);
-				externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass);
+				ApplyLayer(externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass));
 				colliders.push_back(shape);
 				break;
+			//Mesh shapes are owned by the collision shape cache, so they're released along with their collider data
 			case BaseCollider::Shape::Convex:
 				shape = static_cast<ConvexCollider*>(col)->shape;
-				externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass);
-				colliders.push_back(shape);
+				ApplyLayer(externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass));
 				break;
 			case BaseCollider::Shape::Concave:
 				shape = static_cast<ConcaveCollider*>(col)->shape;
-				externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass);
-				colliders.push_back(shape);
+				ApplyLayer(externalBody->addCollisionShape(shape, rp3d::Transform(rpOffset, rp3d::Quaternion::identity()), mass));
+				break;
 			default:
 				break;
 		}
@@ -170,20 +209,61 @@ void Rigidbody::PreUpdate(){
 	}
 
 	//externalBody->setIsActive(GetEnable()); //Touching this breaks everything - TODO
-	externalBody->setTransform(PhysicsEngine::SetupTransform(gameObject));
 
-	externalBody->setLinearVelocity(rp3d::Vector3(linearVelocity.x, linearVelocity.y, linearVelocity.z));
-	externalBody->setAngularVelocity(rp3d::Vector3(angularVelocity.x, angularVelocity.y, angularVelocity.z));
-	externalBody->setMass(mass);
-	externalBody->enableGravity(useGravity);
-	externalBody->getMaterial().setBounciness(material.bounciness);
-	externalBody->getMaterial().setFrictionCoefficient(material.friction);
-	externalBody->setLinearDamping(dampingValue);
-
-	externalBody->applyForceToCenterOfMass(rp3d::Vector3(linearImpulse.x, linearImpulse.y, linearImpulse.z));
+	//Only push what actually changed since the last sync, so that resting bodies are left alone and can go to sleep
+	const rp3d::Transform objectTransform = PhysicsEngine::SetupTransform(gameObject);
+	if(objectTransform != syncedTransform){
+		//Something other than the physics engine moved this object
+		externalBody->setTransform(objectTransform);
+		externalBody->setIsSleeping(false);
+		syncedTransform = objectTransform;
+		//Start interpolating from where it was moved to, otherwise a frame with no steps would slide it back towards the old pose
+		previousTransform = objectTransform;
+	}else if(freezeRotation && !(externalBody->getTransform().getOrientation() == objectTransform.getOrientation())){
+		externalBody->setTransform(objectTransform);
+	}
+
+	const rp3d::Vector3 rpLinearVelocity = rp3d::Vector3(linearVelocity.x, linearVelocity.y, linearVelocity.z);
+	if(externalBody->getLinearVelocity() != rpLinearVelocity){
+		externalBody->setLinearVelocity(rpLinearVelocity);
+	}
+
+	const rp3d::Vector3 rpAngularVelocity = rp3d::Vector3(angularVelocity.x, angularVelocity.y, angularVelocity.z);
+	if(externalBody->getAngularVelocity() != rpAngularVelocity){
+		externalBody->setAngularVelocity(rpAngularVelocity);
+	}
+
+	if(externalBody->getMass() != mass){
+		externalBody->setMass(mass);
+	}
+
+	if(externalBody->isGravityEnabled() != useGravity){
+		externalBody->enableGravity(useGravity);
+	}
+
+	if(externalBody->getMaterial().getBounciness() != material.bounciness){
+		externalBody->getMaterial().setBounciness(material.bounciness);
+	}
+
+	if(externalBody->getMaterial().getFrictionCoefficient() != material.friction){
+		externalBody->getMaterial().setFrictionCoefficient(material.friction);
+	}
+
+	if(externalBody->getLinearDamping() != dampingValue){
+		externalBody->setLinearDamping(dampingValue);
+	}
+
+	//Applying any force wakes the body up, even a zero one
+	const rp3d::Vector3 rpLinearImpulse = rp3d::Vector3(linearImpulse.x, linearImpulse.y, linearImpulse.z);
+	if(!rpLinearImpulse.isZero()){
+		externalBody->applyForceToCenterOfMass(rpLinearImpulse);
+	}
 	linearImpulse = Vector3::Zero();
 
-	externalBody->applyTorque(rp3d::Vector3(angularImpulse.x, angularImpulse.y, angularImpulse.z));
+	const rp3d::Vector3 rpAngularImpulse = rp3d::Vector3(angularImpulse.x, angularImpulse.y, angularImpulse.z);
+	if(!rpAngularImpulse.isZero()){
+		externalBody->applyTorque(rpAngularImpulse);
+	}
 	angularImpulse = Vector3::Zero();
 
 	if(gameObject->IsStatic()){
@@ -205,7 +285,13 @@ void Rigidbody::Update(float deltaTime_){
 
 	ClampLinearVelocity();
 
-	ApplyTransform(externalBody->getTransform());
+	//A sleeping body that has already settled hasn't moved, so there's nothing to write back
+	const rp3d::Transform& currentTransform = externalBody->getTransform();
+	if(!externalBody->isSleeping() || previousTransform != currentTransform){
+		//Blend between the last two steps so motion stays smooth when the frame rate doesn't line up with the physics rate
+		ApplyTransform(rp3d::Transform::interpolateTransforms(previousTransform, currentTransform, PhysicsEngine::InterpolationAlpha()));
+		syncedTransform = PhysicsEngine::SetupTransform(gameObject);
+	}
 
 	//LinearMotion(deltaTime_);
 	//AngularMotion(deltaTime_);
@@ -219,6 +305,24 @@ void Rigidbody::AngularImpulse(const Vector3& impulse_){
 	angularImpulse += impulse_;
 }
 
+void Rigidbody::SetLayer(const std::string& layerName_){
+	const int newLayer = CollisionLayers::GetLayer(layerName_);
+	if(newLayer < 0){
+		Debug::LogWarning("Unknown collision layer " + layerName_ + "!", __FILE__, __LINE__);
+		return;
+	}
+
+	layer = newLayer;
+
+	if(externalBody == nullptr){
+		return;
+	}
+
+	for(rp3d::ProxyShape* ps = externalBody->getProxyShapesList(); ps != nullptr; ps = ps->getNext()){
+		ApplyLayer(ps);
+	}
+}
+
 void Rigidbody::AddCollider(BaseCollider* collider_, const Vector3& offset_){
 	colliderAddQueue.push(collider_);
 	colliderOffsetQueue.push(offset_);
@@ -267,6 +371,11 @@ void Rigidbody::ApplyTransform(const rp3d::Transform& transform_){
 	}
 }
 
+void Rigidbody::ApplyLayer(rp3d::ProxyShape* proxyShape_) const{
+	proxyShape_->setCollisionCategoryBits(CollisionLayers::CategoryBits(layer));
+	proxyShape_->setCollideWithMaskBits(CollisionLayers::CollideWithBits(layer));
+}
+
 //void Rigidbody::LinearMotion(float deltaTime){
 //	if(useGravity){
 //		gameObject->GetTransform()->Translate(linearVelocity * deltaTime + 0.5f * (acceleration + PhysicsEngine::Gravity()) * deltaTime * deltaTime);
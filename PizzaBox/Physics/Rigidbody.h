@@ -1,6 +1,8 @@
 #ifndef RIGIDBODY_H
 #define RIGIDBODY_H
 
+#include <queue>
+
 #include <reactphysics3d.h>
 
 #include "ColliderTypes.h"
@@ -35,6 +37,7 @@ namespace PizzaBox{
 
 		virtual bool Initialize(GameObject* go_) override;
 		virtual void Destroy() override;
+		virtual Component* Clone() const override;
 
 		void PreUpdate();
 		void Update(float deltaTime_);
@@ -81,6 +84,9 @@ namespace PizzaBox{
 			dampingValue = Math::Clamp(0.0f, 1.0f, damping_);
 		}
 
+		int GetLayer() const{ return layer; }
+		void SetLayer(const std::string& layerName_);
+
 	private:
 		friend class PhysicsEngine;
 
@@ -91,8 +97,11 @@ namespace PizzaBox{
 		bool freezeRotation;
 		PhysicsMaterial material;
 		rp3d::RigidBody* externalBody;
+		rp3d::Transform syncedTransform; //The object's transform as of the last time it was synced with externalBody
+		rp3d::Transform previousTransform; //externalBody's transform before the most recent physics step
 		std::vector<rp3d::CollisionShape*> colliders;
 		std::vector<BaseCollider*> colliderData;
+		std::vector<Vector3> colliderOffsets; //Lines up with colliderData
 
 		std::queue<BaseCollider*> colliderAddQueue;
 		std::queue<Vector3> colliderOffsetQueue;
@@ -103,8 +112,10 @@ namespace PizzaBox{
 		Vector3 minLinearVelocity;
 		Vector3 maxLinearVelocity;
 		float dampingValue;
+		int layer;
 
 		void ApplyTransform(const rp3d::Transform& transform_);
+		void ApplyLayer(rp3d::ProxyShape* proxyShape_) const;
 		[[deprecated("This won't work correctly with ReactPhysics")]] void LinearMotion(float deltaTime_);
 		[[deprecated("This won't work correctly with ReactPhysics")]] void AngularMotion(float deltaTime_);
 
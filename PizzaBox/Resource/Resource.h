@@ -1,9 +1,19 @@
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include <cstddef>
 #include <string>
 
 namespace PizzaBox{
+	//Each type has its own budget for resources that are kept loaded after nothing is using them anymore
+	enum class ResourceType{
+		Texture,
+		Model,
+		Audio,
+		Other,
+		Count
+	};
+
 	class Resource{
 	public:
 		Resource(const std::string& file_) : fileName(file_){}
@@ -12,6 +22,15 @@ namespace PizzaBox{
 		virtual bool Load() = 0;
 		virtual void Unload() = 0;
 
+		//Asynchronous loads split Load in two, Decode runs on a worker thread and must not touch OpenGL, FMOD or Lua
+		//Finalize runs on the main thread afterwards, resources that don't split their work up do all of it there
+		virtual bool Decode(){ return true; }
+		virtual bool Finalize(){ return Load(); }
+
+		//Only asked for while the resource is loaded, every resource type should override this or it will never be evicted to make room
+		virtual size_t GetByteSize() const{ return 0; }
+		virtual ResourceType GetType() const{ return ResourceType::Other; }
+
 		inline std::string GetFileName(){ return fileName; }
 
 	protected:
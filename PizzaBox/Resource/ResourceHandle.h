@@ -0,0 +1,26 @@
+#ifndef RESOURCE_HANDLE_H
+#define RESOURCE_HANDLE_H
+
+namespace PizzaBox{
+	//A resource whose name has already been looked up, loading and unloading through it never has to touch a string
+	template <class T> class ResourceHandle{
+	public:
+		static constexpr unsigned int invalidID = static_cast<unsigned int>(-1);
+
+		ResourceHandle() : id(invalidID){}
+		explicit ResourceHandle(unsigned int id_) : id(id_){}
+
+		inline unsigned int GetID() const{ return id; }
+		inline bool IsValid() const{ return id != invalidID; }
+
+		inline bool operator==(const ResourceHandle<T>& other_) const{ return id == other_.id; }
+		inline bool operator!=(const ResourceHandle<T>& other_) const{ return id != other_.id; }
+
+	private:
+		unsigned int id;
+	};
+
+	template <class T> constexpr unsigned int ResourceHandle<T>::invalidID;
+}
+
+#endif //!RESOURCE_HANDLE_H
\ No newline at end of file
@@ -1,15 +1,41 @@
 #include "ResourceManager.h"
 
+#include <chrono>
 #include <iostream>
 
 #include "ResourceParser.h"
+#include "Core/Config.h"
 
 using namespace PizzaBox;
 
 //Initialize Static Variables Here
-std::map<const std::string, ResourceProfile*> ResourceManager::resources = std::map<const std::string, ResourceProfile*>();
+std::vector<ResourceProfile*> ResourceManager::resources = std::vector<ResourceProfile*>();
+std::unordered_map<std::string, unsigned int> ResourceManager::resourceIDs = std::unordered_map<std::string, unsigned int>();
+std::unordered_map<const Resource*, ResourceProfile*> ResourceManager::profiles = std::unordered_map<const Resource*, ResourceProfile*>();
+unsigned int ResourceManager::maxDecodeTasks = 2;
+float ResourceManager::finalizeBudget = 2.0f;
+std::deque<std::shared_ptr<AsyncLoad>> ResourceManager::queuedLoads;
+std::vector<std::shared_ptr<AsyncLoad>> ResourceManager::decodingLoads;
+std::deque<std::shared_ptr<AsyncLoad>> ResourceManager::decodedLoads;
+std::vector<ResourceManager::ResourceCache> ResourceManager::caches;
+bool ResourceManager::isRecording = false;
+bool ResourceManager::isRecordingPaused = false;
+ResourceManifest ResourceManager::recording;
+std::unordered_set<unsigned int> ResourceManager::recordedIDs;
 
 bool ResourceManager::Initialize(){
+	//Always keep at least one worker, otherwise queued loads would never start
+	maxDecodeTasks = static_cast<unsigned int>(std::max(Config::GetInt("AsyncLoadWorkers"), 1));
+	finalizeBudget = Config::GetFloat("AsyncFinalizeBudget");
+
+	//Budgets are in megabytes, a budget of 0 unloads resources as soon as they stop being used
+	constexpr size_t megabyte = 1024 * 1024;
+	caches = std::vector<ResourceCache>(static_cast<size_t>(ResourceType::Count));
+	caches[static_cast<size_t>(ResourceType::Texture)].budget = static_cast<size_t>(std::max(Config::GetInt("TextureCacheBudget"), 0)) * megabyte;
+	caches[static_cast<size_t>(ResourceType::Model)].budget = static_cast<size_t>(std::max(Config::GetInt("ModelCacheBudget"), 0)) * megabyte;
+	caches[static_cast<size_t>(ResourceType::Audio)].budget = static_cast<size_t>(std::max(Config::GetInt("AudioCacheBudget"), 0)) * megabyte;
+	caches[static_cast<size_t>(ResourceType::Other)].budget = static_cast<size_t>(std::max(Config::GetInt("OtherCacheBudget"), 0)) * megabyte;
+
 	if(ResourceParser::ParseEngineResources() == false){
 		Debug::LogError("Could not parse engine resources!", __FILE__, __LINE__);
 		return false;
@@ -24,81 +50,416 @@ bool ResourceManager::Initialize(){
 }
 
 void ResourceManager::Destroy(){
-	for(auto i = resources.begin(); i != resources.end(); i++){
-		delete i->second;
-		i->second = nullptr;
+	//Workers might still be reading into resources that are about to be deleted
+	for(const auto& load : decodingLoads){
+		load->decodeTask.wait();
+	}
+
+	queuedLoads.clear();
+	decodingLoads.clear();
+	decodedLoads.clear();
+
+	//Cached resources are unloaded through their caches first, so the cache bookkeeping is emptied out before the profiles it points into are deleted
+	EvictUnusedResources();
+	caches.clear();
+
+	isRecording = false;
+	isRecordingPaused = false;
+	recording = ResourceManifest();
+	recordedIDs.clear();
+
+	for(auto& r : resources){
+		delete r;
+		r = nullptr;
 	}
 
 	resources.clear();
+	resourceIDs.clear();
+	profiles.clear();
 }
 
 void ResourceManager::AddResource(const std::string& resourceName_, Resource* resource_){
-	//We'll use a lower case version of the name so that creating resources is always case-insensitive
-	std::string name;
-	std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
-
-	if(resources.find(name) != resources.end()){
+	if(FindResource(resourceName_) != ResourceHandle<Resource>::invalidID){
 		Debug::LogWarning("Resource with name [" + resourceName_ + "] already exists in ResourceManager!");
 		return;
 	}
 
-	ResourceProfile* r = new ResourceProfile(resource_, false);
-	resources.insert(std::make_pair(name, r));
+	AddProfile(resourceName_, resource_, false);
 }
 
 void ResourceManager::AddPermanentResource(const std::string& resourceName_, Resource* resource_){
-	//We'll use a lower case version of the name so that creating resources is always case-insensitive
-	std::string name;
-	std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
+	const bool exists = (FindResource(resourceName_) != ResourceHandle<Resource>::invalidID);
+	//This assertion will trigger if a resource with this name has already been added
+	_ASSERT(!exists);
 
-	//This assertion will trigger if a resource with this name is already in the map
-	_ASSERT(resources.find(name) == resources.end());
+	if(!exists){
+		//If there isn't a resource with this name then create one
+		AddProfile(resourceName_, resource_, true);
+	}
+}
 
-	if(resources.find(name) == resources.end()){
-		//If there isn't a resource with this name in the map then create one
-		ResourceProfile* r = new ResourceProfile(resource_, true);
-		resources.insert(std::make_pair(name, r));
+std::string ResourceManager::GetFileName(const std::string& resourceName_){
+	const unsigned int id = FindResource(resourceName_);
+	if(id == ResourceHandle<Resource>::invalidID){
+		return std::string();
 	}
+
+	return resources[id]->resourcePtr->GetFileName();
 }
 
 void ResourceManager::UnloadResource(const std::string& resourceName_){
-	//We'll use a lower case version of the name so that unloading resources is always case-insensitive
-	std::string name;
-	std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
-
+	const unsigned int id = FindResource(resourceName_);
 	//This assertion will trigger if the resource name is invalid
-	_ASSERT(resources.find(name) != resources.end());
-	
-	if(resources[name]->loadCount > 0){
-		resources[name]->loadCount--;
-	}
+	_ASSERT(id != ResourceHandle<Resource>::invalidID);
 
-	if(resources[name]->loadCount == 0 && resources[name]->isPermanent == false){
-		//If this resource isn't being used anywhere and isn't a permanent resource then we unload it
-		resources[name]->resourcePtr->Unload();
+	if(id != ResourceHandle<Resource>::invalidID){
+		ReleaseLoad(id);
 	}
 }
 
 void ResourceManager::LoadPermanentResources(){
-	for(const auto& r : resources){
-		if(!r.second->isPermanent){
+	for(unsigned int i = 0; i < resources.size(); i++){
+		if(!resources[i]->isPermanent){
 			continue;
 		}
 
-		LoadResource<Resource>(r.first);
+		LoadResource(ResourceHandle<Resource>(i));
 	}
 }
 
 void ResourceManager::UnloadPermanentResources(){
-	for(const auto& r : resources){
-		if(!r.second->isPermanent){
+	for(unsigned int i = 0; i < resources.size(); i++){
+		if(!resources[i]->isPermanent){
 			continue;
 		}
 
-		while(r.second->loadCount > 0){
-			UnloadResource(r.first);
+		while(resources[i]->loadCount > 0){
+			ReleaseLoad(i);
 		}
 
-		r.second->resourcePtr->Unload();
+		resources[i]->resourcePtr->Unload();
+	}
+}
+
+void ResourceManager::EvictUnusedResources(){
+	for(ResourceCache& cache : caches){
+		while(!cache.entries.empty()){
+			Evict(cache.entries.front());
+		}
+	}
+
+	EngineStats::SetInt("Resource Cache Bytes", 0);
+}
+
+void ResourceManager::StartRecording(){
+	//This assertion will trigger if a recording is already in progress
+	_ASSERT(!isRecording);
+
+	isRecording = true;
+	recording = ResourceManifest();
+	recordedIDs.clear();
+}
+
+ResourceManifest ResourceManager::StopRecording(){
+	_ASSERT(isRecording);
+
+	isRecording = false;
+	recordedIDs.clear();
+
+	ResourceManifest manifest = recording;
+	recording = ResourceManifest();
+	return manifest;
+}
+
+void ResourceManager::PauseRecording(){
+	//This assertion will trigger if recording is already paused
+	_ASSERT(!isRecordingPaused);
+	isRecordingPaused = true;
+}
+
+void ResourceManager::ResumeRecording(){
+	//This assertion will trigger if recording was never paused
+	_ASSERT(isRecordingPaused);
+	isRecordingPaused = false;
+}
+
+void ResourceManager::Update(){
+	if(queuedLoads.empty() && decodingLoads.empty() && decodedLoads.empty()){
+		return;
+	}
+
+	Debug::StartProfiling("Resource Finalize");
+	const auto start = std::chrono::steady_clock::now();
+
+	//Collect the decodes that have finished without waiting on the ones that haven't
+	for(size_t i = 0; i < decodingLoads.size();){
+		if(decodingLoads[i]->decodeTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready){
+			i++;
+			continue;
+		}
+
+		decodingLoads[i]->state = LoadState::Finalizing;
+		decodedLoads.push_back(decodingLoads[i]);
+		decodingLoads[i] = decodingLoads.back();
+		decodingLoads.pop_back();
+	}
+
+	//Give the workers something to do while we finalize
+	while(decodingLoads.size() < maxDecodeTasks && !queuedLoads.empty()){
+		StartDecode(queuedLoads.front());
+		queuedLoads.pop_front();
+	}
+
+	//At least one resource gets finalized every frame so that a slow one can't hold up loading forever
+	long long finalized = 0;
+	while(!decodedLoads.empty()){
+		const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if(finalized > 0 && elapsed >= finalizeBudget){
+			break;
+		}
+
+		const std::shared_ptr<AsyncLoad> load = decodedLoads.front();
+		decodedLoads.pop_front();
+		FinishLoad(load);
+		finalized++;
+	}
+
+	Debug::EndProfiling("Resource Finalize");
+	EngineStats::AddToInt("Resources Finalized", finalized);
+	EngineStats::SetInt("Resources Loading", static_cast<long long>(queuedLoads.size() + decodingLoads.size() + decodedLoads.size()));
+}
+
+unsigned int ResourceManager::FindResource(const std::string& resourceName_){
+	//We'll use a lower case version of the name so that finding resources is always case-insensitive
+	std::string name;
+	std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
+	EngineStats::AddToInt("Resource Lookups", 1);
+
+	const auto id = resourceIDs.find(name);
+	if(id == resourceIDs.end()){
+		return ResourceHandle<Resource>::invalidID;
+	}
+
+	return id->second;
+}
+
+void ResourceManager::AddProfile(const std::string& resourceName_, Resource* resource_, bool permanent_){
+	std::string name;
+	std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
+
+	//The name is interned here, everything after this can go through the ID
+	const unsigned int id = static_cast<unsigned int>(resources.size());
+	ResourceProfile* r = new ResourceProfile(id, name, resource_, permanent_);
+	resources.push_back(r);
+	resourceIDs.insert(std::make_pair(name, id));
+	profiles.insert(std::make_pair(resource_, r));
+}
+
+void ResourceManager::ReleaseLoad(unsigned int id_){
+	_ASSERT(id_ < resources.size());
+	ResourceProfile* profile = resources[id_];
+
+	//Loads aren't counted until an async load finishes, so releasing a request before then gives up its share of that load instead
+	if(profile->loadCount == 0 && profile->pendingLoad != nullptr){
+		CancelRequest(profile);
+		return;
+	}
+
+	//Releasing something that was never loaded would put a resource that isn't loaded into the cache
+	if(profile->loadCount == 0){
+		return;
+	}
+
+	profile->loadCount--;
+
+	if(profile->loadCount == 0 && profile->isPermanent == false){
+		//If this resource isn't being used anywhere and isn't a permanent resource then it either gets cached or unloaded
+		AddToCache(id_);
+	}
+}
+
+void ResourceManager::AddToCache(unsigned int id_){
+	ResourceProfile* profile = resources[id_];
+	const ResourceType type = profile->resourcePtr->GetType();
+	ResourceCache& cache = caches[static_cast<size_t>(type)];
+
+	if(cache.budget == 0){
+		profile->resourcePtr->Unload();
+		return;
+	}
+
+	//The size is taken now, while the resource is still loaded
+	profile->isCached = true;
+	profile->cachedSize = profile->resourcePtr->GetByteSize();
+	profile->cacheEntry = cache.entries.insert(cache.entries.end(), id_);
+	cache.usedBytes += profile->cachedSize;
+
+	TrimCache(type);
+}
+
+void ResourceManager::RemoveFromCache(ResourceProfile* profile_){
+	_ASSERT(profile_ != nullptr);
+	_ASSERT(profile_->isCached);
+
+	ResourceCache& cache = caches[static_cast<size_t>(profile_->resourcePtr->GetType())];
+	cache.entries.erase(profile_->cacheEntry);
+	cache.usedBytes -= profile_->cachedSize;
+
+	profile_->isCached = false;
+	profile_->cachedSize = 0;
+	profile_->cacheEntry = std::list<unsigned int>::iterator();
+}
+
+void ResourceManager::TrimCache(ResourceType type_){
+	ResourceCache& cache = caches[static_cast<size_t>(type_)];
+	while(cache.usedBytes > cache.budget && !cache.entries.empty()){
+		Evict(cache.entries.front());
+	}
+
+	size_t totalBytes = 0;
+	for(const ResourceCache& c : caches){
+		totalBytes += c.usedBytes;
+	}
+
+	EngineStats::SetInt("Resource Cache Bytes", static_cast<long long>(totalBytes));
+}
+
+void ResourceManager::Evict(unsigned int id_){
+	ResourceProfile* profile = resources[id_];
+	RemoveFromCache(profile);
+	profile->resourcePtr->Unload();
+	EngineStats::AddToInt("Resource Cache Evictions", 1);
+}
+
+void ResourceManager::RecordLoad(unsigned int id_){
+	if(!isRecording || isRecordingPaused){
+		return;
+	}
+
+	_ASSERT(id_ < resources.size());
+	const ResourceProfile* profile = resources[id_];
+	if(profile->isPermanent || recordedIDs.insert(id_).second == false){
+		return;
+	}
+
+	recording.resources.push_back(ResourceHandle<Resource>(id_));
+	if(profile->loadCount == 0 && profile->isCached == false && profile->pendingLoad == nullptr){
+		recording.loadsFromDisk++;
+	}
+}
+
+std::shared_ptr<AsyncLoad> ResourceManager::RequestLoad(ResourceProfile* profile_){
+	_ASSERT(profile_ != nullptr);
+
+	//Requests made while a load is in flight just wait on that load
+	if(profile_->pendingLoad != nullptr){
+		profile_->pendingLoad->requests++;
+		return profile_->pendingLoad;
+	}
+
+	std::shared_ptr<AsyncLoad> load = std::make_shared<AsyncLoad>(profile_->name, profile_, profile_->resourcePtr);
+	load->requests = 1;
+
+	if(profile_->isCached){
+		//Nothing was using it but it never got unloaded, so it can be used again as is
+		RemoveFromCache(profile_);
+		EngineStats::AddToInt("Resource Cache Hits", 1);
+		profile_->loadCount++;
+		load->state = LoadState::Ready;
+		return load;
 	}
+
+	if(profile_->loadCount > 0){
+		//Already loaded, so there's nothing to wait for
+		profile_->loadCount++;
+		load->state = LoadState::Ready;
+		return load;
+	}
+
+	if(profile_->isPermanent == false){
+		EngineStats::AddToInt("Resource Cache Misses", 1);
+	}
+
+	profile_->pendingLoad = load;
+	queuedLoads.push_back(load);
+	return load;
+}
+
+void ResourceManager::CancelRequest(ResourceProfile* profile_){
+	_ASSERT(profile_ != nullptr);
+	_ASSERT(profile_->pendingLoad != nullptr);
+
+	const std::shared_ptr<AsyncLoad> load = profile_->pendingLoad;
+	if(load->requests == 0){
+		return;
+	}
+
+	load->requests--;
+	if(load->requests > 0 || load->state != LoadState::Queued || profile_->isPermanent){
+		//Loads that a worker has already started are left to finish, FinishLoad puts them in the cache since nothing wants them
+		return;
+	}
+
+	//Nothing has been done for this load yet, so it can just be dropped
+	queuedLoads.erase(std::remove(queuedLoads.begin(), queuedLoads.end(), load), queuedLoads.end());
+	profile_->pendingLoad = nullptr;
+	load->state = LoadState::Failed;
+	EngineStats::AddToInt("Resource Loads Cancelled", 1);
+}
+
+void ResourceManager::StartDecode(const std::shared_ptr<AsyncLoad>& load_){
+	_ASSERT(load_ != nullptr);
+
+	Resource* resource = load_->resource;
+	load_->state = LoadState::Decoding;
+	load_->decodeTask = std::async(std::launch::async, [resource](){ return resource->Decode(); });
+	decodingLoads.push_back(load_);
+}
+
+bool ResourceManager::CompletePendingLoad(ResourceProfile* profile_){
+	_ASSERT(profile_ != nullptr);
+	_ASSERT(profile_->pendingLoad != nullptr);
+
+	const std::shared_ptr<AsyncLoad> load = profile_->pendingLoad;
+	queuedLoads.erase(std::remove(queuedLoads.begin(), queuedLoads.end(), load), queuedLoads.end());
+	decodingLoads.erase(std::remove(decodingLoads.begin(), decodingLoads.end(), load), decodingLoads.end());
+	decodedLoads.erase(std::remove(decodedLoads.begin(), decodedLoads.end(), load), decodedLoads.end());
+
+	return FinishLoad(load);
+}
+
+bool ResourceManager::FinishLoad(const std::shared_ptr<AsyncLoad>& load_){
+	_ASSERT(load_ != nullptr);
+	ResourceProfile* profile = load_->profile;
+
+	bool decoded = false;
+	if(load_->decodeTask.valid()){
+		//This only blocks if the worker hasn't finished yet
+		decoded = load_->decodeTask.get();
+	}else{
+		//This load never made it to a worker, so do the whole thing here
+		decoded = load_->resource->Decode();
+	}
+
+	profile->pendingLoad = nullptr;
+
+	if(decoded == false || load_->resource->Finalize() == false){
+		Debug::LogError("Resource [" + load_->name + "] couldn't be loaded!", __FILE__, __LINE__);
+		load_->state = LoadState::Failed;
+		return false;
+	}
+
+	if(profile->isPermanent){
+		profile->loadCount++; //Add an extra load to the load count to ensure the permanent resource never gets reloaded
+	}
+
+	profile->loadCount += load_->requests;
+	load_->state = LoadState::Ready;
+
+	//Every request for this load was released while it was in flight
+	if(profile->loadCount == 0){
+		AddToCache(profile->id);
+	}
+
+	return true;
 }
\ No newline at end of file
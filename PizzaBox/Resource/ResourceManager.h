@@ -2,18 +2,32 @@
 #define RESOURCE_MANAGER_H
 
 #include <algorithm>
-#include <map>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "Resource.h"
+#include "ResourceHandle.h"
+#include "ResourceRequest.h"
 #include"../Tools/Debug.h"
+#include"../Tools/EngineStats.h"
 
 namespace PizzaBox{
 	struct ResourceProfile{
+		unsigned int id;
+		std::string name;
 		Resource* resourcePtr;
 		unsigned int loadCount;
 		bool isPermanent;
+		std::shared_ptr<AsyncLoad> pendingLoad; //Set while an asynchronous load of this resource is in flight
+		bool isCached; //Still loaded after its last load was released, until it's used again or evicted
+		size_t cachedSize;
+		std::list<unsigned int>::iterator cacheEntry;
 
-		ResourceProfile(Resource* resource_, const bool permanent_) : resourcePtr(resource_), loadCount(0), isPermanent(permanent_){}
+		ResourceProfile(unsigned int id_, const std::string& name_, Resource* resource_, const bool permanent_) : id(id_), name(name_), resourcePtr(resource_), loadCount(0), isPermanent(permanent_), pendingLoad(nullptr), isCached(false), cachedSize(0), cacheEntry(){}
 
 		~ResourceProfile(){ 
 			if(resourcePtr != nullptr){
@@ -24,6 +38,14 @@ namespace PizzaBox{
 		}
 	};
 	
+	//Every resource that was loaded while the manifest was being recorded, so they can all be loaded ahead of time later
+	struct ResourceManifest{
+		ResourceManifest() : resources(), loadsFromDisk(0){}
+
+		std::vector<ResourceHandle<Resource>> resources;
+		unsigned int loadsFromDisk; //How many of them weren't already loaded or cached when they were asked for
+	};
+
 	class ResourceManager{
 	public:
 		static bool Initialize();
@@ -32,40 +54,128 @@ namespace PizzaBox{
 		static void AddResource(const std::string& resourceName_, Resource* resource_);
 		static void AddPermanentResource(const std::string& resourceName_, Resource* resource_);
 
+		//Looks a resource's name up once, after that the handle can be loaded and unloaded without touching strings
+		//Returns an invalid handle if there's no resource with this name
+		template <class T> static ResourceHandle<T> GetHandle(const std::string& resourceName_){
+			const unsigned int id = FindResource(resourceName_);
+			//If the conversion fails then the resource name doesn't match the resource type, and this assertion will trigger
+			_ASSERT(id == ResourceHandle<T>::invalidID || dynamic_cast<T*>(resources[id]->resourcePtr) != nullptr);
+			return ResourceHandle<T>(id);
+		}
+
 		template <class T> static T* LoadResource(const std::string& resourceName_){
-			//We'll use a lower case version of the name so that loading resources is always case-insensitive
-			std::string name;
-			std::transform(resourceName_.begin(), resourceName_.end(), std::back_inserter(name), tolower);
+			return LoadResource(GetHandle<T>(resourceName_));
+		}
 
+		template <class T> static T* LoadResource(const ResourceHandle<T>& handle_){
 			//This assertion will trigger if this resource name is invalid
-			_ASSERT(resources.find(name) != resources.end());
+			_ASSERT(handle_.IsValid());
+			if(!handle_.IsValid()){
+				Debug::LogError("Tried to load a resource that doesn't exist!", __FILE__, __LINE__);
+				return nullptr;
+			}
 
-			//Convert the resource to a T*
-			T* source = dynamic_cast<T*>(resources[name]->resourcePtr);
-			//If the conversion fails then the resource name doesn't match the resource type, and this assertion will trigger
-			_ASSERT(source != nullptr);
+			ResourceProfile* profile = resources[handle_.GetID()];
+			//GetHandle already made sure the resource is a T
+			T* source = static_cast<T*>(profile->resourcePtr);
+			RecordLoad(handle_.GetID());
 
-			if(resources[name]->loadCount == 0){
+			//If this resource is already being loaded asynchronously, finish that load now instead of loading it twice
+			if(profile->pendingLoad != nullptr && CompletePendingLoad(profile) == false){
+				return nullptr;
+			}
+
+			if(profile->isCached){
+				//Nothing was using it but it never got unloaded, so it can be used again as is
+				RemoveFromCache(profile);
+				EngineStats::AddToInt("Resource Cache Hits", 1);
+			}else if(profile->loadCount == 0){
 				//Load the resource if it hasn't already been loaded
-				if(resources[name]->resourcePtr->Load() == false){
+				if(profile->resourcePtr->Load() == false){
 					Debug::Log("Resource couldn't be loaded!", __FILE__, __LINE__);
 					return nullptr;
 				}
 
-				if(resources[name]->isPermanent){
-					resources[name]->loadCount++; //Add an extra load to the load count to ensure the permanent resource never gets reloaded
+				if(profile->isPermanent == false){
+					EngineStats::AddToInt("Resource Cache Misses", 1);
+				}
+
+				if(profile->isPermanent){
+					profile->loadCount++; //Add an extra load to the load count to ensure the permanent resource never gets reloaded
 				}
 			}
 
-			resources[name]->loadCount++;
+			profile->loadCount++;
 			return source;
 		}
 		
+		//Decodes the resource on a worker thread and finalizes it on the main thread during Update, so that loading it doesn't stall a frame
+		//Resources that are already loaded come back ready straight away
+		template <class T> static ResourceRequest<T> LoadResourceAsync(const std::string& resourceName_){
+			return LoadResourceAsync(GetHandle<T>(resourceName_));
+		}
+
+		template <class T> static ResourceRequest<T> LoadResourceAsync(const ResourceHandle<T>& handle_){
+			//This assertion will trigger if this resource name is invalid
+			_ASSERT(handle_.IsValid());
+			if(!handle_.IsValid()){
+				return ResourceRequest<T>();
+			}
+
+			RecordLoad(handle_.GetID());
+			return ResourceRequest<T>(RequestLoad(resources[handle_.GetID()]));
+		}
+
+		//Collects finished decodes, starts queued ones and finalizes decoded resources until this frame's budget runs out
+		static void Update();
+
+		//Adds a load to a resource that's already loaded, so that copies of something holding it don't have to look its name up again
+		//Every reference still has to be matched with a call to UnloadResource
+		template <class T> static T* AddReference(T* resource_){
+			if(resource_ == nullptr){
+				return nullptr;
+			}
+
+			const auto profile = profiles.find(resource_);
+			//This assertion will trigger if the resource didn't come from the ResourceManager
+			_ASSERT(profile != profiles.end());
+			//This assertion will trigger if the resource isn't loaded, in which case LoadResource should be used instead
+			_ASSERT(profile->second->loadCount > 0);
+
+			RecordLoad(profile->second->id);
+			profile->second->loadCount++;
+			EngineStats::AddToInt("Resource References", 1);
+			return resource_;
+		}
+
 		static void UnloadResource(const std::string& resourceName_);
 
+		template <class T> static void UnloadResource(const ResourceHandle<T>& handle_){
+			ReleaseLoad(handle_.GetID());
+		}
+
+		//The name a handle was made from, for error messages
+		template <class T> static std::string GetName(const ResourceHandle<T>& handle_){
+			return handle_.IsValid() ? resources[handle_.GetID()]->name : std::string();
+		}
+
+		//The file a resource is loaded from, without loading it, or an empty string if there's no resource with this name
+		static std::string GetFileName(const std::string& resourceName_);
+
 		static void LoadPermanentResources();
 		static void UnloadPermanentResources();
 
+		//Unloads every resource that's only still loaded because it fit in its type's cache budget
+		static void EvictUnusedResources();
+
+		//Records every resource that gets loaded between these two calls, permanent resources are left out since they're always loaded
+		static void StartRecording();
+		static ResourceManifest StopRecording();
+		inline static bool IsRecording(){ return isRecording; }
+		//Loads made while recording is paused are left out, for loads that are made on behalf of something other than what's being recorded
+		static void PauseRecording();
+		static void ResumeRecording();
+
 		//Delete unwanted compiler generated constructors, assignment operators and destructors
 		ResourceManager() = delete;
 		ResourceManager(const ResourceManager&) = delete;
@@ -75,7 +185,53 @@ namespace PizzaBox{
 		~ResourceManager() = delete;
 
 	private:
-		static std::map<const std::string, ResourceProfile*> resources;
+		static std::vector<ResourceProfile*> resources; //Indexed by the IDs names get interned into when they're added
+		static std::unordered_map<std::string, unsigned int> resourceIDs;
+		static std::unordered_map<const Resource*, ResourceProfile*> profiles; //Lets AddReference find a profile without the resource's name
+
+		static unsigned int maxDecodeTasks;
+		static float finalizeBudget; //How many milliseconds Update can spend finalizing resources each frame
+		static std::deque<std::shared_ptr<AsyncLoad>> queuedLoads; //Waiting for a free worker
+		static std::vector<std::shared_ptr<AsyncLoad>> decodingLoads;
+		static std::deque<std::shared_ptr<AsyncLoad>> decodedLoads; //Waiting to be finalized on the main thread
+
+		//Resources nobody is using stay loaded until their type goes over its budget, then the least recently used ones get unloaded first
+		struct ResourceCache{
+			ResourceCache() : budget(0), usedBytes(0), entries(){}
+
+			size_t budget;
+			size_t usedBytes;
+			std::list<unsigned int> entries; //Least recently used at the front
+		};
+
+		static std::vector<ResourceCache> caches; //Indexed by ResourceType
+
+		static bool isRecording;
+		static bool isRecordingPaused;
+		static ResourceManifest recording;
+		static std::unordered_set<unsigned int> recordedIDs;
+
+		//Returns the ID this name was interned into, or ResourceHandle's invalidID if there's no such resource
+		static unsigned int FindResource(const std::string& resourceName_);
+		static void AddProfile(const std::string& resourceName_, Resource* resource_, bool permanent_);
+		static void ReleaseLoad(unsigned int id_);
+		//Has to be called before the load is counted, so that it can tell whether the resource has to come from disk
+		static void RecordLoad(unsigned int id_);
+
+		static void AddToCache(unsigned int id_);
+		static void RemoveFromCache(ResourceProfile* profile_);
+		//Unloads the least recently used resources of this type until it fits in its budget again
+		static void TrimCache(ResourceType type_);
+		static void Evict(unsigned int id_);
+
+		static std::shared_ptr<AsyncLoad> RequestLoad(ResourceProfile* profile_);
+		//Gives up one request on a pending load, dropping the load entirely if it hasn't been started and nothing else wants it
+		static void CancelRequest(ResourceProfile* profile_);
+		static void StartDecode(const std::shared_ptr<AsyncLoad>& load_);
+		//Takes a pending load out of whichever queue it's in and finishes it right away
+		static bool CompletePendingLoad(ResourceProfile* profile_);
+		//Waits for the decode if it's still running, then finalizes the resource and hands out the loads it was requested for
+		static bool FinishLoad(const std::shared_ptr<AsyncLoad>& load_);
 	};
 }
 
@@ -0,0 +1,59 @@
+#ifndef RESOURCE_REQUEST_H
+#define RESOURCE_REQUEST_H
+
+#include <future>
+#include <memory>
+#include <string>
+
+#include "Resource.h"
+
+namespace PizzaBox{
+	struct ResourceProfile;
+
+	enum class LoadState{
+		Queued,
+		Decoding,
+		Finalizing,
+		Ready,
+		Failed
+	};
+
+	//One asynchronous load of a resource, shared by every request made for that resource while it's in flight
+	struct AsyncLoad{
+		AsyncLoad(const std::string& name_, ResourceProfile* profile_, Resource* resource_) : name(name_), profile(profile_), resource(resource_), state(LoadState::Queued), requests(0), decodeTask(){}
+
+		std::string name;
+		ResourceProfile* profile;
+		Resource* resource;
+		LoadState state; //Only ever changed on the main thread
+		unsigned int requests; //Each request gets one load once the resource has been finalized
+		std::future<bool> decodeTask;
+	};
+
+	//Returned by ResourceManager::LoadResourceAsync, the resource can be used once IsReady returns true
+	//A ready request holds one load just like LoadResource does, so it has to be matched with a call to ResourceManager::UnloadResource
+	template <class T> class ResourceRequest{
+	public:
+		ResourceRequest(const std::shared_ptr<const AsyncLoad>& load_ = nullptr) : load(load_){}
+
+		inline bool IsReady() const{ return load != nullptr && load->state == LoadState::Ready; }
+		inline bool IsFailed() const{ return load == nullptr || load->state == LoadState::Failed; }
+		inline bool IsDone() const{ return IsReady() || IsFailed(); }
+		inline LoadState GetState() const{ return (load == nullptr) ? LoadState::Failed : load->state; }
+
+		//Returns nullptr until the resource is ready
+		T* Get() const{
+			if(!IsReady()){
+				return nullptr;
+			}
+
+			//LoadResourceAsync already checked that the resource is a T
+			return static_cast<T*>(load->resource);
+		}
+
+	private:
+		std::shared_ptr<const AsyncLoad> load;
+	};
+}
+
+#endif //!RESOURCE_REQUEST_H
\ No newline at end of file
@@ -76,15 +76,15 @@ void Script::OnCollisionExit(GameObject* other_){
 void Script::OnUI(UIEvent event_){
 }
 
-void Script::RegisterCollisionEnter(CollisionInfo& info_){
-	collisionEnterQueue.push(info_);
+void Script::RegisterCollisionEnter(const CollisionInfo& info_){
+	ScriptManager::QueueCollisionEvent(this, CollisionEventType::Enter, info_);
 }
 
-void Script::RegisterCollisionStay(CollisionInfo& info_){
-	collisionStayQueue.push(info_);
+void Script::RegisterCollisionStay(const CollisionInfo& info_){
+	ScriptManager::QueueCollisionEvent(this, CollisionEventType::Stay, info_);
 }
 
 void Script::RegisterCollisionExit(GameObject* other_){
 	_ASSERT(other_ != nullptr);
-	collisionExitQueue.push(other_);
+	ScriptManager::QueueCollisionEvent(this, CollisionEventType::Exit, CollisionInfo(other_, Vector3::Zero()));
 }
\ No newline at end of file
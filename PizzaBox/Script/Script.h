@@ -1,8 +1,6 @@
 #ifndef SCRIPT_H
 #define SCRIPT_H
 
-#include <queue>
-
 #include "Object/Component.h"
 #include "Object/GameObject.h"
 
@@ -13,10 +11,12 @@ namespace PizzaBox{
 	};
 
 	struct CollisionInfo{
-		CollisionInfo(GameObject* other_, const Vector3& normal_) : other(other_), normal(normal_){}
+		CollisionInfo(GameObject* other_, const Vector3& normal_, bool isTrigger_ = false) : other(other_), otherHandle(other_ != nullptr ? other_->GetHandle() : GameObjectHandle()), normal(normal_), isTrigger(isTrigger_){}
 
 		GameObject* other;
+		GameObjectHandle otherHandle; //Events are queued for a frame, so this is how ScriptManager can tell if other was destroyed in the meantime
 		Vector3 normal;
+		bool isTrigger; //True if either object is a trigger volume, in which case there is no contact normal
 	};
 	
 	class Script : public Component{
@@ -39,8 +39,8 @@ namespace PizzaBox{
 		
 		virtual void OnUI(UIEvent event_);
 
-		void RegisterCollisionEnter(CollisionInfo& info_);
-		void RegisterCollisionStay(CollisionInfo& info_);
+		void RegisterCollisionEnter(const CollisionInfo& info_);
+		void RegisterCollisionStay(const CollisionInfo& info_);
 		void RegisterCollisionExit(GameObject* other_);
 
 	private:
@@ -48,9 +48,6 @@ namespace PizzaBox{
 		friend class ScriptManager;
 
 		bool hasStarted;
-		std::queue<CollisionInfo> collisionEnterQueue;
-		std::queue<CollisionInfo> collisionStayQueue;
-		std::queue<GameObject*> collisionExitQueue;
 	};
 }
 
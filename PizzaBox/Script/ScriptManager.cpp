@@ -1,14 +1,25 @@
 #include "ScriptManager.h"
 
+#include <algorithm>
+
+#include "Tools/Debug.h"
+#include "Tools/EngineStats.h"
+
 using namespace PizzaBox;
 
 std::vector<Script*> ScriptManager::scripts;
+std::vector<ScriptManager::CollisionEvent> ScriptManager::collisionEvents;
+std::vector<ScriptManager::CollisionEvent> ScriptManager::dispatchingEvents;
 
 bool ScriptManager::Initialize(){
 	return true;
 }
 
 void ScriptManager::Destroy(){
+	collisionEvents.clear();
+	collisionEvents.shrink_to_fit();
+	dispatchingEvents.clear();
+	dispatchingEvents.shrink_to_fit();
 }
 
 void ScriptManager::RegisterScript(Script* script_){
@@ -19,37 +30,84 @@ void ScriptManager::RegisterScript(Script* script_){
 void ScriptManager::UnregisterScript(Script* script_){
 	_ASSERT(script_ != nullptr);
 	scripts.erase(std::remove(scripts.begin(), scripts.end(), script_), scripts.end());
+
+	//Don't leave events pointing at a script that's about to be deleted
+	collisionEvents.erase(std::remove_if(collisionEvents.begin(), collisionEvents.end(), [script_](const CollisionEvent& event_){
+		return event_.script == script_;
+	}), collisionEvents.end());
+
+	//The events being delivered can't be erased from under the dispatch loop, so just stop them from being delivered
+	for(CollisionEvent& event : dispatchingEvents){
+		if(event.script == script_){
+			event.script = nullptr;
+		}
+	}
+}
+
+void ScriptManager::QueueCollisionEvent(GameObject* receiver_, CollisionEventType type_, const CollisionInfo& info_){
+	_ASSERT(receiver_ != nullptr);
+
+	for(Script* script : receiver_->GetScripts()){
+		collisionEvents.push_back(CollisionEvent(script, type_, info_));
+	}
+}
+
+void ScriptManager::QueueCollisionEvent(Script* script_, CollisionEventType type_, const CollisionInfo& info_){
+	_ASSERT(script_ != nullptr);
+	collisionEvents.push_back(CollisionEvent(script_, type_, info_));
 }
 
 void ScriptManager::Update(const float deltaTime_){
+	//Start any new scripts first so that they're ready for this frame's collision events
+	for(Script* script : scripts){
+		if(script->GetEnable() && !script->HasStarted()){
+			script->OnStart();
+			script->hasStarted = true;
+		}
+	}
+
+	Debug::StartProfiling("Script Collision Events");
+	EngineStats::SetInt("Script Collision Events", static_cast<int>(collisionEvents.size()));
+
+	//Anything a handler queues goes into the now empty collisionEvents and is delivered next frame
+	dispatchingEvents.swap(collisionEvents);
+	DispatchCollisionEvents(CollisionEventType::Enter);
+	DispatchCollisionEvents(CollisionEventType::Stay);
+	DispatchCollisionEvents(CollisionEventType::Exit);
+	dispatchingEvents.clear();
+
+	Debug::EndProfiling("Script Collision Events");
+
 	for(Script* script : scripts){
 		if(script->GetEnable()){
-			//Start the script
-			if(!script->HasStarted()){
-				script->OnStart();
-				script->hasStarted = true;
-			}
-
-			//Handle Collision Enter
-			while(!script->collisionEnterQueue.empty()){
-				script->OnCollision(script->collisionEnterQueue.front());
-				script->collisionEnterQueue.pop();
-			}
-
-			//Handle Continued Collisions
-			while(!script->collisionStayQueue.empty()){
-				script->OnCollisionStay(script->collisionStayQueue.front());
-				script->collisionStayQueue.pop();
-			}
-
-			//Handle Collision Exits
-			while(!script->collisionExitQueue.empty()){
-				script->OnCollisionExit(script->collisionExitQueue.front());
-				script->collisionExitQueue.pop();
-			}
-
-			//Update
 			script->Update(deltaTime_);
 		}
 	}
+}
+
+void ScriptManager::DispatchCollisionEvents(CollisionEventType type_){
+	for(size_t i = 0; i < dispatchingEvents.size(); i++){
+		//Copied, since a handler can destroy scripts and so change the list while this event is still being delivered
+		const CollisionEvent event = dispatchingEvents[i];
+		if(event.type != type_ || event.script == nullptr || !event.script->GetEnable()){
+			continue;
+		}
+
+		//The other object was destroyed after this event was queued, so there's nothing left to tell the script about
+		if(event.info.other != nullptr && !event.info.otherHandle.IsValid()){
+			continue;
+		}
+
+		switch(type_){
+			case CollisionEventType::Enter:
+				event.script->OnCollision(event.info);
+				break;
+			case CollisionEventType::Stay:
+				event.script->OnCollisionStay(event.info);
+				break;
+			case CollisionEventType::Exit:
+				event.script->OnCollisionExit(event.info.other);
+				break;
+		}
+	}
 }
\ No newline at end of file
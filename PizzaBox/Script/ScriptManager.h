@@ -6,6 +6,12 @@
 #include "Script.h"
 
 namespace PizzaBox{
+	enum class CollisionEventType{
+		Enter,
+		Stay,
+		Exit
+	};
+
 	class ScriptManager{
 	public:
 		static bool Initialize();
@@ -14,10 +20,29 @@ namespace PizzaBox{
 		static void RegisterScript(Script* script_);
 		static void UnregisterScript(Script* script_);
 
+		//Sends the event to every script on the receiver, or does nothing if it has none
+		static void QueueCollisionEvent(GameObject* receiver_, CollisionEventType type_, const CollisionInfo& info_);
+		static void QueueCollisionEvent(Script* script_, CollisionEventType type_, const CollisionInfo& info_);
+
 		static void Update(const float deltaTime_);
 
 	private:
+		struct CollisionEvent{
+			CollisionEvent(Script* script_, CollisionEventType type_, const CollisionInfo& info_) : script(script_), type(type_), info(info_){}
+
+			Script* script;
+			CollisionEventType type;
+			CollisionInfo info;
+		};
+
 		static std::vector<Script*> scripts;
+		//Every collision event queued for the next dispatch
+		static std::vector<CollisionEvent> collisionEvents;
+		//The events being delivered this frame, swapped out of collisionEvents so that handlers can queue more without disturbing them
+		//The two swap back and forth each frame, so neither releases its memory
+		static std::vector<CollisionEvent> dispatchingEvents;
+
+		static void DispatchCollisionEvents(CollisionEventType type_);
 	};
 }
 
@@ -3,6 +3,7 @@
 #include <csignal>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <rttr/registration.h> //This breaks if it goes below Windows.h
 #include <Windows.h>
@@ -18,6 +19,7 @@ using namespace PizzaBox;
 std::map<const std::string, Profiler*> Debug::profilers = std::map<const std::string, Profiler*>();
 const HANDLE Debug::hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 RayManager* Debug::rayManager = nullptr;
+std::recursive_mutex Debug::logMutex;
 
 //Suppress meaningless and unavoidable warning
 #pragma warning( push )
@@ -88,6 +90,8 @@ void Debug::Destroy(){
 
 void Debug::Log(const std::string& log_, const std::string& file_, int line_){
 	#ifdef _DEBUG
+	//Resources log from their decode workers, so only one message can be written at a time
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_GREEN);
 	std::string fileName = GetFileName(file_);
 	std::cout << log_ << "\n\t\t\t || File:  " << fileName << ", Line: " << line_ << std::endl;
@@ -98,6 +102,7 @@ void Debug::Log(const std::string& log_, const std::string& file_, int line_){
 
 void Debug::Log(const std::string& log_){
 	#ifdef _DEBUG
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_BLUE | FOREGROUND_GREEN);
 	std::cout << log_ << std::endl;
 	WriteLogFile(log_);
@@ -107,6 +112,7 @@ void Debug::Log(const std::string& log_){
 
 void Debug::LogWarning(const std::string& warning_, const std::string& file_, int line_){
 	#ifdef _DEBUG
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN);
 	std::string fileName = GetFileName(file_);
 	std::cout << "Warning: " << warning_ << "\n\t\t\t || File:  " << fileName << ", Line: " << line_ << std::endl;
@@ -117,6 +123,7 @@ void Debug::LogWarning(const std::string& warning_, const std::string& file_, in
 
 void Debug::LogWarning(const std::string& warning_){
 	#ifdef _DEBUG
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN);
 	std::cout << "Warning: " << warning_ << std::endl;
 	WriteLogFile("Warning: " + warning_);
@@ -126,6 +133,7 @@ void Debug::LogWarning(const std::string& warning_){
 
 void Debug::LogError(const std::string& error_, const std::string& file_, int line_){
 	#ifdef _DEBUG
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_RED);
 	std::string fileName = GetFileName(file_);
 	std::cout << "Error: " << error_ << "\n\t\t\t || File:  " << fileName << ", Line: " << line_ << std::endl;
@@ -136,6 +144,7 @@ void Debug::LogError(const std::string& error_, const std::string& file_, int li
 
 void Debug::LogError(const std::string& error_){
 	#ifdef _DEBUG
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	SetConsoleTextAttribute(hConsole, FOREGROUND_RED);
 	std::cout << "Error: " << error_ << std::endl;
 	WriteLogFile("Error: " + error_);
@@ -151,6 +160,7 @@ void Debug::DisplayFatalErrorMessage(const std::string& title_, const std::strin
 		LogError(message_,__FILE__, __LINE__);
 	}
 	std::string fileName = GetFileName(__FILE__);
+	std::lock_guard<std::recursive_mutex> lock(logMutex);
 	WriteLogFile(title_ + ": " + message_, fileName, __LINE__);
 }
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <map>
+#include <mutex>
 
 #include "Profiler.h" 
 #include "Graphics/Color.h"
@@ -67,6 +68,7 @@ namespace PizzaBox{
 		static const HANDLE hConsole;
 		static std::map<const std::string, Profiler*> profilers;
 		static RayManager* rayManager;
+		static std::recursive_mutex logMutex; //Guards the console colour, std::cout and the log file, recursive since writing the log file can log its own errors
 
 		static void WriteLogFile(const std::string& message, const std::string& file, int line);
 		static void WriteLogFile(const std::string& message);
@@ -76,7 +76,7 @@ void LuaManager::Destroy(){
 	}
 }
 
-bool LuaManager::EnableScript(const std::string& scriptName_, const std::string& script_){
+bool LuaManager::EnableScript(const std::string& scriptName_, StringView script_){
 	#ifdef _DEBUG
 	if(state == nullptr){
 		Debug::LogError("LuaState was not active!", __FILE__, __LINE__);
@@ -84,7 +84,12 @@ bool LuaManager::EnableScript(const std::string& scriptName_, const std::string&
 	}
 	#endif //_DEBUG
 
-	int result = luaL_dostring(state, script_.c_str());
+	//The script is usually viewed straight out of its file, so it isn't null terminated and has to be loaded as a buffer
+	int result = luaL_loadbuffer(state, script_.data(), script_.size(), scriptName_.c_str());
+	if(result == LUA_OK){
+		result = lua_pcall(state, 0, LUA_MULTRET, 0);
+	}
+
 	if(result != LUA_OK){
 		Debug::LogError("Script was not executed successfully! Lua Error: " + std::string(lua_tostring(state, -1)));
 		return false;
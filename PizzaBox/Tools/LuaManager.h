@@ -4,13 +4,15 @@
 #include <lua.hpp>
 #include <rttr/registration.h>
 
+#include "Core/StringView.h"
+
 namespace PizzaBox{
 	class LuaManager{
 	public:
 		static bool Initialize();
 		static void Destroy();
 
-		static bool EnableScript(const std::string& scriptName_, const std::string& script_);
+		static bool EnableScript(const std::string& scriptName_, StringView script_);
 		static void DisableScript(const std::string& scriptName_);
 
 		template <typename... ARGS>
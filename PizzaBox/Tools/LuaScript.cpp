@@ -1,37 +1,48 @@
 #include "LuaScript.h"
 
-#include "Core/FileSystem.h"
 #include "Tools/Debug.h"
 #include "Tools/LuaManager.h"
 
 using namespace PizzaBox;
 
-LuaScript::LuaScript(const std::string& filePath_) : Resource(filePath_), scriptName(){
+LuaScript::LuaScript(const std::string& filePath_) : Resource(filePath_), scriptName(), byteSize(0), decodedFile(){
 }
 
 LuaScript::~LuaScript(){
 }
 
 bool LuaScript::Load(){
-	if(FileSystem::FileExists(fileName) == false){
+	return Decode() && Finalize();
+}
+
+bool LuaScript::Decode(){
+	if(decodedFile.Open(fileName) == false){
 		Debug::LogError("Script file [" + fileName + "] does not exist!", __FILE__, __LINE__);
 		return false;
 	}
 
-	std::string fileContents = FileSystem::ReadFileToString(fileName);
-	if(fileContents.empty()){
+	if(decodedFile.Size() == 0){
 		Debug::LogError("Script file [" + fileName + "] was empty!", __FILE__, __LINE__);
+		decodedFile.Close();
 		return false;
 	}
 
-	auto fileContentsInLines = FileSystem::ReadFile(fileName);
-	std::string firstLine = fileContentsInLines[0];
-	scriptName = firstLine.substr(0, firstLine.find(" "));
+	//The script's name is the first word of its first line
+	const StringView firstLine = *decodedFile.Lines().begin();
+	scriptName = firstLine.substr(0, firstLine.find(' ')).ToString();
+	byteSize = decodedFile.Size();
+	return true;
+}
 
-	return LuaManager::EnableScript(scriptName, fileContents);
+bool LuaScript::Finalize(){
+	//The Lua state can only be touched from the main thread
+	const bool enabled = LuaManager::EnableScript(scriptName, decodedFile.View());
+	decodedFile.Close();
+	return enabled;
 }
 
 void LuaScript::Unload(){
 	LuaManager::DisableScript(scriptName);
 	scriptName = "";
+	byteSize = 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef LUA_SCRIPT_H
 #define LUA_SCRIPT_H
 
+#include "Core/MappedFile.h"
 #include "Resource/Resource.h"
 
 namespace PizzaBox{
@@ -11,9 +12,14 @@ namespace PizzaBox{
 
 		virtual bool Load() override;
 		virtual void Unload() override;
+		virtual bool Decode() override;
+		virtual bool Finalize() override;
+		virtual size_t GetByteSize() const override{ return byteSize; }
 
 	private:
 		std::string scriptName;
+		size_t byteSize; //Lua keeps its own copy of the script, which is about as big as the source
+		MappedFile decodedFile; //Mapped by Decode, handed to Lua by Finalize
 	};
 }
 